@@ -0,0 +1,245 @@
+/**
+ * @file autoplayer.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief autoplayer.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "autoplayer.hpp"
+
+static const int DX[4] = {0, 0, -1, 1};
+static const int DY[4] = {-1, 1, 0, 0};
+static const Autoplayer::Action DIR_ACTION[4] = {
+    Autoplayer::Action::UP,
+    Autoplayer::Action::DOWN,
+    Autoplayer::Action::LEFT,
+    Autoplayer::Action::RIGHT
+};
+
+Autoplayer::Autoplayer(unsigned long long seed) : rng(seed) {
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            this->danger[y][x] = false;
+        }
+    }
+}
+
+bool Autoplayer::passable(const Board& b, int x, int y) const {
+    if (x < 0 || y < 0 || x >= (int)b.getWidth() ||
+    y >= (int)b.getHeight()){
+        return false;
+    }
+
+    if (!b.isWalkable((unsigned short)x, (unsigned short)y)){
+        return false;
+    }
+
+    return b.getCell((unsigned short)x, (unsigned short)y)
+    != Board::CellType::EXPLOSION;
+}
+
+void Autoplayer::markBlast(const Board& b, unsigned short bx,
+unsigned short by, unsigned short range) {
+    this->danger[by][bx] = true;
+
+    for (int dir = 0; dir < 4; dir++) {
+        for (int r = 1; r <= (int)range; r++) {
+            int nx = (int)bx + DX[dir] * r;
+            int ny = (int)by + DY[dir] * r;
+
+            if (nx < 0 || ny < 0 || nx >= (int)b.getWidth() ||
+            ny >= (int)b.getHeight()){
+                break;
+            }
+
+            Board::CellType c = b.getCell(
+                (unsigned short)nx, (unsigned short)ny
+            );
+            if (c == Board::CellType::WALL_SOLID ||
+            c == Board::CellType::WALL_DESTRUCTIBLE){
+                break;
+            }
+            this->danger[ny][nx] = true;
+        }
+    }
+}
+
+void Autoplayer::computeDanger(const Level& level, const Player& p) {
+    const Board& b = level.getBoard();
+
+    for (int y = 0; y < (int)b.getHeight(); y++) {
+        for (int x = 0; x < (int)b.getWidth(); x++) {
+            this->danger[y][x] = b.getCell(
+                (unsigned short)x, (unsigned short)y
+            ) == Board::CellType::EXPLOSION;
+        }
+    }
+
+    // bombs don't expose their range, the current player range
+    // plus one is a safe upper bound
+    const list<Bomb*>& bombs = level.getBombs();
+    for (unsigned int i = 0; i < bombs.len(); i++) {
+        Bomb* bomb = bombs.at(i);
+        if (bomb == nullptr || !bomb->isPlaced()){
+            continue;
+        }
+        this->markBlast(b, bomb->getX(), bomb->getY(),
+        p.getBombRange() + 1);
+    }
+}
+
+bool Autoplayer::worthBombing(const Level& level, int x, int y) const {
+    const Board& b = level.getBoard();
+
+    for (int dir = 0; dir < 4; dir++) {
+        int nx = x + DX[dir];
+        int ny = y + DY[dir];
+        if (nx < 0 || ny < 0 || nx >= (int)b.getWidth() ||
+        ny >= (int)b.getHeight()){
+            continue;
+        }
+        if (b.getCell((unsigned short)nx, (unsigned short)ny) ==
+        Board::CellType::WALL_DESTRUCTIBLE){
+            return true;
+        }
+    }
+
+    const list<Enemy*>& enemies = level.getEnemies();
+    for (unsigned int i = 0; i < enemies.len(); i++) {
+        Enemy* e = enemies.at(i);
+        int ex = (int)e->getX();
+        int ey = (int)e->getY();
+
+        int dx = ex - x;
+        int dy = ey - y;
+        if (dx < 0) dx = -dx;
+        if (dy < 0) dy = -dy;
+
+        if ((dx == 0 && dy <= 2) || (dy == 0 && dx <= 2)){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Autoplayer::Action Autoplayer::search(const Level& level,
+int sx, int sy, int goal) {
+    const Board& b = level.getBoard();
+    const int w = (int)b.getWidth();
+    const int h = (int)b.getHeight();
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            this->parent[y][x] = -1;
+        }
+    }
+
+    int head = 0;
+    int tail = 0;
+
+    this->queue[tail++] = (short)(sy * w + sx);
+    this->parent[sy][sx] = (short)(sy * w + sx);
+
+    while (head < tail) {
+        int cur = this->queue[head++];
+        int cx = cur % w;
+        int cy = cur / w;
+
+        bool isStart = (cx == sx && cy == sy);
+
+        bool reached = false;
+        if (!isStart) {
+            if (goal == 0) {
+                reached = !this->danger[cy][cx];
+            } else {
+                reached = this->worthBombing(level, cx, cy);
+            }
+        }
+
+        if (reached) {
+            // walk back to the first step
+            int step = cur;
+            while (this->parent[step / w][step % w] != sy * w + sx) {
+                step = this->parent[step / w][step % w];
+            }
+            int fx = step % w - sx;
+            int fy = step / w - sy;
+            for (int dir = 0; dir < 4; dir++) {
+                if (DX[dir] == fx && DY[dir] == fy){
+                    return DIR_ACTION[dir];
+                }
+            }
+            return Autoplayer::Action::NONE;
+        }
+
+        // shuffled neighbour order keeps paths varied
+        int start = this->rng.nextInt(0, 3);
+        for (int k = 0; k < 4; k++) {
+            int dir = (start + k) % 4;
+            int nx = cx + DX[dir];
+            int ny = cy + DY[dir];
+
+            if (!this->passable(b, nx, ny)){
+                continue;
+            }
+            if (this->parent[ny][nx] != -1){
+                continue;
+            }
+            // hunting never walks into a blast
+            if (goal == 1 && this->danger[ny][nx]){
+                continue;
+            }
+
+            this->parent[ny][nx] = (short)cur;
+            this->queue[tail++] = (short)(ny * w + nx);
+        }
+    }
+
+    return Autoplayer::Action::NONE;
+}
+
+Autoplayer::Action Autoplayer::decide(const Level& level,
+const Player& p) {
+    this->computeDanger(level, p);
+
+    const int px = (int)p.getX();
+    const int py = (int)p.getY();
+
+    // run first
+    if (this->danger[py][px]) {
+        return this->search(level, px, py, 0);
+    }
+
+    // one bomb at a time, and only with an escape route
+    if (level.getBombs().len() == 0 &&
+    this->worthBombing(level, px, py)) {
+        this->markBlast(level.getBoard(), (unsigned short)px,
+        (unsigned short)py, p.getBombRange() + 1);
+
+        if (this->search(level, px, py, 0) != Autoplayer::Action::NONE){
+            return Autoplayer::Action::BOMB;
+        }
+        this->computeDanger(level, p);
+    }
+
+    Autoplayer::Action a = this->search(level, px, py, 1);
+    if (a != Autoplayer::Action::NONE){
+        return a;
+    }
+
+    // nothing to do, random safe step
+    int dir = this->rng.nextInt(0, 3);
+    int nx = px + DX[dir];
+    int ny = py + DY[dir];
+    if (this->passable(level.getBoard(), nx, ny) &&
+    !this->danger[ny][nx]){
+        return DIR_ACTION[dir];
+    }
+
+    return Autoplayer::Action::NONE;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file autoplayer.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief scripted player used by the soak benchmark
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * the autoplayer looks at the level like a human would (board,
+ * bombs, enemies) and returns one action per tick
+ *
+ * it is not meant to be good at the game, only to keep every
+ * subsystem busy: it blows up walls, hunts enemies in straight
+ * lines and runs away from its own bombs
+ *
+ */
+
+#ifndef AUTOPLAYER_HPP
+#define AUTOPLAYER_HPP
+
+#include "level.hpp"
+#include "maps.hpp"
+#include "player.hpp"
+#include "random.hpp"
+
+/**
+ * @brief deterministic bot driving a Player inside a Level
+ */
+class Autoplayer {
+public:
+    /**
+     * @brief action chosen for the current tick
+     */
+    enum Action {
+        NONE,
+        UP,
+        DOWN,
+        LEFT,
+        RIGHT,
+        BOMB
+    };
+
+private:
+    Random rng;
+
+    // cells hit by a bomb that is already placed
+    bool danger[MAP_HEIGHT][MAP_WIDTH];
+
+    // bfs scratch buffers
+    short parent[MAP_HEIGHT][MAP_WIDTH];
+    short queue[MAP_HEIGHT * MAP_WIDTH];
+
+    /**
+     * @brief marks the blast cross of a bomb in danger
+     */
+    void markBlast(const Board& b, unsigned short bx,
+    unsigned short by, unsigned short range);
+
+    /**
+     * @brief rebuilds the danger grid from bombs and explosions
+     */
+    void computeDanger(const Level& level, const Player& p);
+
+    /**
+     * @brief true if the player can stand on (x,y) right now
+     */
+    bool passable(const Board& b, int x, int y) const;
+
+    /**
+     * @brief true if a bomb here would destroy something useful
+     */
+    bool worthBombing(const Level& level, int x, int y) const;
+
+    /**
+     * @brief breadth first search from (sx,sy)
+     *
+     * goal selects the target cell:
+     * 0 = nearest cell out of danger,
+     * 1 = nearest safe cell worth bombing
+     *
+     * @return first step toward the target, NONE if unreachable
+     */
+    Autoplayer::Action search(const Level& level, int sx, int sy,
+    int goal);
+
+public:
+    /**
+     * @brief creates an autoplayer with a fixed seed
+     */
+    Autoplayer(unsigned long long seed);
+
+    /**
+     * @brief chooses the action for this tick
+     */
+    Autoplayer::Action decide(const Level& level, const Player& p);
+};
+
+#endif
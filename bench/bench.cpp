@@ -0,0 +1,129 @@
+/**
+ * @file bench.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief bench.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <cstring>
+
+Bench::Result Bench::results[Bench::MAX_RESULTS];
+unsigned Bench::count = 0;
+
+unsigned Bench::warmup = 3;
+unsigned Bench::repeats = 15;
+const char* Bench::filter = nullptr;
+
+volatile unsigned long long Bench::sink = 0;
+
+void Bench::configure(unsigned warmup, unsigned repeats) {
+    if (repeats < 1){
+        repeats = 1;
+    }
+    if (repeats > Bench::MAX_REPEATS){
+        repeats = Bench::MAX_REPEATS;
+    }
+
+    Bench::warmup = warmup;
+    Bench::repeats = repeats;
+}
+
+void Bench::setFilter(const char* f) {
+    if (f != nullptr && f[0] == '\0'){
+        f = nullptr;
+    }
+    Bench::filter = f;
+}
+
+bool Bench::selected(const char* name) {
+    if (Bench::filter == nullptr){
+        return true;
+    }
+    return strstr(name, Bench::filter) != nullptr;
+}
+
+void Bench::consume(unsigned long long v) {
+    Bench::sink = Bench::sink + v;
+}
+
+void Bench::record(const char* name, unsigned iterations,
+double* samples, unsigned n) {
+    if (Bench::count >= Bench::MAX_RESULTS || n == 0){
+        return;
+    }
+
+    // insertion sort, n is small
+    for (unsigned i = 1; i < n; i++) {
+        double v = samples[i];
+        unsigned j = i;
+        while (j > 0 && samples[j - 1] > v) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = v;
+    }
+
+    double sum = 0.0;
+    for (unsigned i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+    double mean = sum / (double)n;
+
+    double var = 0.0;
+    for (unsigned i = 0; i < n; i++) {
+        var += (samples[i] - mean) * (samples[i] - mean);
+    }
+    if (n > 1){
+        var /= (double)(n - 1);
+    }
+
+    double median = samples[n / 2];
+    if (n % 2 == 0){
+        median = (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    }
+
+    Bench::Result& r = Bench::results[Bench::count++];
+
+    strncpy(r.name, name, sizeof(r.name) - 1);
+    r.name[sizeof(r.name) - 1] = '\0';
+    r.iterations = iterations;
+    r.repeats = n;
+    r.minNs = samples[0];
+    r.maxNs = samples[n - 1];
+    r.meanNs = mean;
+    r.medianNs = median;
+    r.stddevNs = std::sqrt(var);
+
+    // progress goes to stderr, stdout stays valid JSON
+    fprintf(stderr, "%-44s median %12.1f ns\n", r.name, r.medianNs);
+}
+
+void Bench::printJson(FILE* out) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"unit\": \"ns/op\",\n");
+    fprintf(out, "  \"warmup\": %u,\n", Bench::warmup);
+    fprintf(out, "  \"repeats\": %u,\n", Bench::repeats);
+    fprintf(out, "  \"results\": [\n");
+
+    for (unsigned i = 0; i < Bench::count; i++) {
+        const Bench::Result& r = Bench::results[i];
+        fprintf(out,
+            "    {\"name\": \"%s\", \"iterations\": %u, "
+            "\"repeats\": %u, \"min\": %.2f, \"max\": %.2f, "
+            "\"mean\": %.2f, \"median\": %.2f, \"stddev\": %.2f}%s\n",
+            r.name, r.iterations, r.repeats,
+            r.minNs, r.maxNs, r.meanNs, r.medianNs, r.stddevNs,
+            (i + 1 < Bench::count) ? "," : ""
+        );
+    }
+
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bench.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief tiny micro-benchmark harness
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the Bench class used by the benchmark binary
+ * (make bench)
+ *
+ * every benchmark runs a fixed number of warm-up passes, then
+ * a fixed number of measured repeats, each one calling the body
+ * a fixed number of times
+ *
+ * iteration counts are never calibrated at runtime, so two runs
+ * on the same machine always execute the same amount of work
+ *
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @brief static micro-benchmark runner
+ *
+ * results are collected in a fixed size table and printed
+ * as a single JSON document at the end of the run
+ */
+class Bench {
+public:
+    /**
+     * @brief maximum number of measured repeats per benchmark
+     */
+    static const unsigned MAX_REPEATS = 64;
+
+    /**
+     * @brief maximum number of benchmarks per run
+     */
+    static const unsigned MAX_RESULTS = 128;
+
+    /**
+     * @brief statistics of one benchmark (nanoseconds per call)
+     */
+    struct Result {
+        char name[64];
+        unsigned iterations;
+        unsigned repeats;
+        double minNs;
+        double maxNs;
+        double meanNs;
+        double medianNs;
+        double stddevNs;
+    };
+
+private:
+    static Bench::Result results[Bench::MAX_RESULTS];
+    static unsigned count;
+
+    // run parameters (shared by every benchmark)
+    static unsigned warmup;
+    static unsigned repeats;
+    static const char* filter;
+
+    // sink used to keep results alive
+    static volatile unsigned long long sink;
+
+    /**
+     * @brief true if name passes the current filter
+     */
+    static bool selected(const char* name);
+
+    /**
+     * @brief computes statistics and stores a new result
+     *
+     * @param samples ns/call of every measured repeat
+     */
+    static void record(const char* name, unsigned iterations,
+    double* samples, unsigned n);
+
+public:
+    /**
+     * @brief sets warm-up and repeat counts
+     *
+     * repeats is clamped to [1, MAX_REPEATS]
+     */
+    static void configure(unsigned warmup, unsigned repeats);
+
+    /**
+     * @brief only benchmarks whose name contains f will run
+     *
+     * null or empty string disables the filter
+     */
+    static void setFilter(const char* f);
+
+    /**
+     * @brief runs a benchmark
+     *
+     * body is called iterations times per repeat, the
+     * reported time is the average cost of a single call
+     *
+     * @param name unique benchmark name (group/case/size)
+     * @param iterations calls per repeat
+     * @param body callable with no arguments
+     */
+    template <typename F>
+    static void run(const char* name, unsigned iterations, F body) {
+        if (!Bench::selected(name) || iterations == 0){
+            return;
+        }
+
+        for (unsigned w = 0; w < Bench::warmup; w++) {
+            for (unsigned i = 0; i < iterations; i++) {
+                body();
+            }
+        }
+
+        double samples[Bench::MAX_REPEATS];
+
+        for (unsigned r = 0; r < Bench::repeats; r++) {
+            auto t0 = std::chrono::steady_clock::now();
+            for (unsigned i = 0; i < iterations; i++) {
+                body();
+            }
+            auto t1 = std::chrono::steady_clock::now();
+
+            double ns = (double)std::chrono::duration_cast<
+            std::chrono::nanoseconds>(t1 - t0).count();
+            samples[r] = ns / (double)iterations;
+        }
+
+        Bench::record(name, iterations, samples, Bench::repeats);
+    }
+
+    /**
+     * @brief keeps a computed value alive so the
+     * optimizer can't drop the benchmark body
+     */
+    static void consume(unsigned long long v);
+
+    /**
+     * @brief prints every collected result as JSON
+     */
+    static void printJson(FILE* out);
+};
+
+#endif
@@ -0,0 +1,809 @@
+/**
+ * @file main.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief micro-benchmarks entry point (make bench)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file contains the micro-benchmarks for the core data
+ * structures and the hot gameplay kernels
+ *
+ * usage: bombergirl_bench [--filter TEXT] [--warmup N] [--repeats N]
+ *
+ * JSON results are written to stdout, progress to stderr
+ *
+ */
+
+#include "bench.hpp"
+
+#include "ansi_terminal.hpp"
+#include "board.hpp"
+#include "bomb.hpp"
+#include "bonus_pack.hpp"
+#include "enemies.hpp"
+#include "framebuffer.hpp"
+#include "leaderboard.hpp"
+#include "level.hpp"
+#include "levelpack.hpp"
+#include "list.hpp"
+#include "map_generator.hpp"
+#include "maps.hpp"
+#include "parser.hpp"
+#include "player.hpp"
+#include "powerup.hpp"
+#include "random.hpp"
+#include "render.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+// every benchmark uses fixed seeds, runs must be repeatable
+static const unsigned long long BENCH_SEED = 0x5EEDB0BBULL;
+
+// SECTION LIST
+
+static void benchList() {
+    const unsigned sizes[3] = {8, 64, 512};
+    char name[64];
+
+    for (int s = 0; s < 3; s++) {
+        const unsigned n = sizes[s];
+        // keep the amount of work per repeat roughly constant
+        const unsigned iters = 262144 / (n * 4) + 1;
+
+        snprintf(name, sizeof(name), "list/push_back_clear/%u", n);
+        Bench::run(name, iters, [n]() {
+            list<int> l;
+            for (unsigned i = 0; i < n; i++) {
+                l.push_back((int)i);
+            }
+            Bench::consume(l.len());
+            l.clear();
+        });
+
+        list<int> scan;
+        for (unsigned i = 0; i < n; i++) {
+            scan.push_back((int)i);
+        }
+
+        snprintf(name, sizeof(name), "list/at_scan/%u", n);
+        Bench::run(name, iters, [&scan]() {
+            unsigned long long sum = 0;
+            for (unsigned i = 0; i < scan.len(); i++) {
+                sum += (unsigned long long)scan.at(i);
+            }
+            Bench::consume(sum);
+        });
+
+        // steady size churn: one node freed and one allocated per call
+        snprintf(name, sizeof(name), "list/remove_mid_push_back/%u", n);
+        Bench::run(name, iters * 4, [&scan]() {
+            int v = scan.remove(scan.len() / 2);
+            scan.push_back(v);
+        });
+
+        snprintf(name, sizeof(name), "list/push_front_pop_front/%u", n);
+        Bench::run(name, iters * 4, [&scan]() {
+            scan.push_front(1);
+            Bench::consume((unsigned long long)scan.pop_front());
+        });
+    }
+}
+
+//!SECTION
+
+// SECTION BOARD
+
+/**
+ * @brief fills a board like a classic level
+ * (solid border, solid pillars, some destructibles)
+ */
+static void fillBoard(Board& b, unsigned long long seed) {
+    Random rng(seed);
+    for (unsigned short y = 0; y < b.getHeight(); y++) {
+        for (unsigned short x = 0; x < b.getWidth(); x++) {
+            bool border = x == 0 || y == 0 ||
+            x == b.getWidth() - 1 || y == b.getHeight() - 1;
+
+            if (border || (x % 2 == 0 && y % 2 == 0)) {
+                b.setCell(x, y, Board::CellType::WALL_SOLID);
+            } else if (rng.nextInt(0, 99) < 30) {
+                b.setCell(x, y, Board::CellType::WALL_DESTRUCTIBLE);
+            } else {
+                b.setCell(x, y, Board::CellType::EMPTY);
+            }
+        }
+    }
+}
+
+static void benchBoard() {
+    Board board(MAP_WIDTH, MAP_HEIGHT);
+    fillBoard(board, BENCH_SEED);
+
+    Bench::run("board/getCell_full_scan", 4096, [&board]() {
+        unsigned long long sum = 0;
+        for (unsigned short y = 0; y < board.getHeight(); y++) {
+            for (unsigned short x = 0; x < board.getWidth(); x++) {
+                sum += (unsigned long long)board.getCell(x, y);
+            }
+        }
+        Bench::consume(sum);
+    });
+
+    Bench::run("board/isWalkable_full_scan", 4096, [&board]() {
+        unsigned long long sum = 0;
+        for (unsigned short y = 0; y < board.getHeight(); y++) {
+            for (unsigned short x = 0; x < board.getWidth(); x++) {
+                sum += board.isWalkable(x, y) ? 1 : 0;
+            }
+        }
+        Bench::consume(sum);
+    });
+
+    Bench::run("board/clearExplosions", 4096, [&board]() {
+        board.clearExplosions();
+    });
+
+    // explosions active on a percentage of the empty cells
+    const int percents[3] = {0, 10, 100};
+    char name[64];
+
+    for (int p = 0; p < 3; p++) {
+        const int pct = percents[p];
+        Board eb(MAP_WIDTH, MAP_HEIGHT);
+        fillBoard(eb, BENCH_SEED);
+
+        snprintf(name, sizeof(name), "board/updateExplosions/%d%%", pct);
+
+        Random rng(BENCH_SEED);
+        Bench::run(name, 4096, [&eb, &rng, pct]() {
+            // re-arm explosions so every call sees the same load,
+            // ttl 15 is only reached again after the set
+            if (pct > 0) {
+                for (unsigned short y = 1; y < eb.getHeight() - 1; y++) {
+                    for (unsigned short x = 1; x < eb.getWidth() - 1; x++) {
+                        Board::CellType c = eb.getCell(x, y);
+                        if (c == Board::CellType::EMPTY &&
+                        rng.nextInt(0, 99) < pct) {
+                            eb.setCell(x, y, Board::CellType::EXPLOSION);
+                        }
+                    }
+                }
+            }
+            eb.updateExplosions();
+            eb.clearExplosions();
+        });
+    }
+}
+
+//!SECTION
+
+// SECTION BOMB
+
+static void benchBomb() {
+    const unsigned short ranges[3] = {1, 3, 8};
+    const unsigned enemyCounts[3] = {0, 8, 64};
+    char name[64];
+
+    const unsigned short bx = MAP_WIDTH / 2;
+    const unsigned short by = MAP_HEIGHT / 2;
+
+    for (int ri = 0; ri < 3; ri++) {
+        for (int ei = 0; ei < 3; ei++) {
+            const unsigned short range = ranges[ri];
+            const unsigned enemiesWanted = enemyCounts[ei];
+
+            // open arena, the blast is only stopped by the border
+            Board board(MAP_WIDTH, MAP_HEIGHT);
+            for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+                board.setCell(x, 0, Board::CellType::WALL_SOLID);
+                board.setCell(x, MAP_HEIGHT - 1, Board::CellType::WALL_SOLID);
+            }
+            for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+                board.setCell(0, y, Board::CellType::WALL_SOLID);
+                board.setCell(MAP_WIDTH - 1, y, Board::CellType::WALL_SOLID);
+            }
+
+            Player player;
+            player.reset();
+            player.setBoard(&board);
+            player.setMaxBombs(1);
+            player.setLives(3);
+            // the owner stands on the bomb, keep it alive
+            player.setInvulnerability(65535);
+
+            // enemies are placed outside the blast cross, so they
+            // survive and every call scans the same list
+            list<Enemy*> enemies;
+            Random placer(BENCH_SEED);
+            while (enemies.len() < enemiesWanted) {
+                unsigned short ex = (unsigned short)placer.nextInt(
+                    1, MAP_WIDTH - 2);
+                unsigned short ey = (unsigned short)placer.nextInt(
+                    1, MAP_HEIGHT - 2);
+                if (ex == bx || ey == by){
+                    continue;
+                }
+                enemies.push_back(new Walker(&board, ex, ey, BENCH_SEED));
+            }
+
+            EnemyPool enemyPool;
+            list<PowerUp*> powerUps;
+            PowerUpPool powerUpPool;
+            Random rng(BENCH_SEED);
+
+            snprintf(name, sizeof(name), "bomb/explode/r%u/e%u",
+            (unsigned)range, enemiesWanted);
+
+            Bench::run(name, 8192, [&]() {
+                player.setX(bx);
+                player.setY(by);
+                Bomb b(&board, &player, 90, range);
+                b.explode(enemies, enemyPool, powerUps, powerUpPool, rng);
+                // restore the arena for the next call
+                board.clearExplosions();
+            });
+
+            while (enemies.len() > 0) {
+                delete enemies.pop_back();
+            }
+        }
+    }
+}
+
+//!SECTION
+
+// SECTION CHASER
+
+static void benchChaser() {
+    Board board(MAP_WIDTH, MAP_HEIGHT);
+    for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+        board.setCell(x, 0, Board::CellType::WALL_SOLID);
+        board.setCell(x, MAP_HEIGHT - 1, Board::CellType::WALL_SOLID);
+    }
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        board.setCell(0, y, Board::CellType::WALL_SOLID);
+        board.setCell(MAP_WIDTH - 1, y, Board::CellType::WALL_SOLID);
+    }
+
+    Player player;
+    player.reset();
+    player.setBoard(&board);
+
+    const unsigned short cx = 1;
+    const unsigned short cy = 10;
+    Chaser chaser(&board, &player, cx, cy, BENCH_SEED);
+
+    struct Case {
+        const char* name;
+        unsigned short px, py;
+        bool wall;
+    };
+
+    const Case cases[5] = {
+        {"chaser/seesPlayer/row_d1", cx + 1, cy, false},
+        {"chaser/seesPlayer/row_d16", cx + 16, cy, false},
+        {"chaser/seesPlayer/col_d8", cx, cy + 8, false},
+        {"chaser/seesPlayer/row_blocked", cx + 16, cy, true},
+        {"chaser/seesPlayer/not_aligned", cx + 5, cy + 5, false},
+    };
+
+    for (int i = 0; i < 5; i++) {
+        const Case& c = cases[i];
+        player.setX(c.px);
+        player.setY(c.py);
+
+        Board::CellType wall = c.wall ?
+        Board::CellType::WALL_DESTRUCTIBLE : Board::CellType::EMPTY;
+        board.setCell(cx + 8, cy, wall);
+
+        Bench::run(c.name, 262144, [&chaser]() {
+            Bench::consume(chaser.seesPlayer(16) ? 1 : 0);
+        });
+    }
+}
+
+//!SECTION
+
+// SECTION PARSER
+
+/**
+ * @brief writes a full bonus map (one line per cell)
+ * @return false if the file can't be written
+ */
+static bool writeBonusFile(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == nullptr){
+        return false;
+    }
+
+    fprintf(f, "# generated by bombergirl_bench\n");
+    Random rng(BENCH_SEED);
+
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            int type = 0;
+            int sx = 0, sy = 0, ex = 0, ey = 0, speed = 0;
+
+            bool border = x == 0 || y == 0 ||
+            x == MAP_WIDTH - 1 || y == MAP_HEIGHT - 1;
+
+            if (border) {
+                type = (int)_TileType::SOLID;
+            } else if (x == 1 && y == 1) {
+                type = (int)_TileType::SPAWN;
+            } else if (x == MAP_WIDTH - 2 && y == MAP_HEIGHT - 2) {
+                type = (int)_TileType::GATE_NEXT;
+            } else if (x % 2 == 0 && y % 2 == 0) {
+                type = (int)_TileType::SOLID;
+            } else if (x % 7 == 3 && y % 5 == 3) {
+                type = (int)_TileType::WALKER;
+                sx = x; sy = y; speed = 12;
+            } else if (rng.nextInt(0, 99) < 30) {
+                type = (int)_TileType::DESTRUCTIBLE;
+            }
+
+            fprintf(f, "%d;%d;%d;%d;%d;%d;%d;%d\n",
+            type, x, y, sx, sy, ex, ey, speed);
+        }
+    }
+
+    fclose(f);
+    return true;
+}
+
+static void benchParser() {
+    char path[] = "/tmp/bombergirl_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "parser: cannot create temp file, skipped\n");
+        return;
+    }
+    close(fd);
+
+    if (!writeBonusFile(path)) {
+        fprintf(stderr, "parser: cannot write temp file, skipped\n");
+        unlink(path);
+        return;
+    }
+
+    Map* map = new Map();
+    char err[128];
+
+    Bench::run("parser/loadBonusFile/full_map", 256, [&]() {
+        bool ok = Parser::loadBonusFile(path, *map, err, 128);
+        Bench::consume(ok ? 1 : 0);
+    });
+
+    // the same file in memory, repeated up to 4 MB: the copies are
+    // duplicates, every line is still tokenized and converted
+    FILE* f = fopen(path, "rb");
+    char* file = new char[64 * 1024];
+    std::size_t fileSize = f != nullptr ? fread(file, 1, 64 * 1024, f) : 0;
+    if (f != nullptr){
+        fclose(f);
+    }
+
+    const std::size_t BIG = 4 * 1024 * 1024;
+    char* big = new char[BIG + 64 * 1024];
+    std::size_t bigSize = 0;
+    while (fileSize > 0 && bigSize < BIG) {
+        memcpy(big + bigSize, file, fileSize);
+        bigSize += fileSize;
+    }
+
+    Parser::Diagnostics diag;
+    Bench::run("parser/parseBuffer/full_map", 1024, [&]() {
+        bool ok = Parser::parseBuffer(file, fileSize, *map, &diag);
+        Bench::consume(ok ? 1 : 0);
+    });
+
+    Bench::run("parser/parseBuffer/4MB", 4, [&]() {
+        Parser::parseBuffer(big, bigSize, *map, &diag);
+        Bench::consume((unsigned long long)diag.total);
+    });
+
+    // the same level 1000 times as a multi-level file, bonus mode
+    // starts with open() and the first read()
+    FILE* pack = fopen(path, "wb");
+    for (int i = 0; pack != nullptr && i < 1000; i++) {
+        fputs("@level;27;22\n", pack);
+        fwrite(file, 1, fileSize, pack);
+        fputc('\n', pack);
+    }
+    if (pack != nullptr){
+        fclose(pack);
+    }
+
+    BonusPack bonus;
+    Bench::run("bonuspack/open_read_first/1000_levels", 256, [&]() {
+        bonus.open(path, &diag);
+        Bench::consume((unsigned long long)bonus.read(0, *map, &diag));
+        bonus.close();
+    });
+
+    // levels in file order, as the background loader reads them
+    bonus.open(path, &diag);
+    int next = 0;
+    Bench::run("bonuspack/read_next/1000_levels", 1000, [&]() {
+        Bench::consume((unsigned long long)bonus.read(next, *map, &diag));
+        next = (next + 1) % 1000;
+    });
+    bonus.close();
+
+    delete[] big;
+    delete[] file;
+    delete map;
+    unlink(path);
+}
+
+//!SECTION
+
+// SECTION LEVEL PACK
+
+static void benchLevelPack() {
+    char path[] = "/tmp/bombergirl_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "levelpack: cannot create temp file, skipped\n");
+        return;
+    }
+    close(fd);
+
+    // 256 levels, the builtin maps repeated
+    const unsigned int LEVELS = 256;
+    Map* builtin[5] = {
+        new Map(MapBuilder::motherboard()), new Map(MapBuilder::ram()),
+        new Map(MapBuilder::storage()), new Map(MapBuilder::cpu()),
+        new Map(MapBuilder::gpu())
+    };
+    const Map* maps[LEVELS];
+    for (unsigned int i = 0; i < LEVELS; i++) {
+        maps[i] = builtin[i % 5];
+    }
+
+    try {
+        LevelPack::write(path, maps, nullptr, LEVELS);
+    } catch (const LevelPack::WriteException&) {
+        fprintf(stderr, "levelpack: cannot write temp file, skipped\n");
+        unlink(path);
+        for (int i = 0; i < 5; i++) {
+            delete builtin[i];
+        }
+        return;
+    }
+
+    Bench::run("levelpack/open/256", 1024, [&]() {
+        LevelPack pack;
+        pack.open(path);
+        Bench::consume(pack.size());
+    });
+
+    LevelPack pack;
+    pack.open(path);
+
+    Player player;
+    player.reset();
+    Level level(&player, MAP_WIDTH, MAP_HEIGHT, *builtin[0]);
+
+    // same level from the two sources
+    Bench::run("level/reset/map", 4096, [&]() {
+        level.reset(*builtin[0]);
+        Bench::consume(level.getEnemies().len());
+    });
+
+    Bench::run("level/reset/pack", 4096, [&]() {
+        level.reset(pack.at(0));
+        Bench::consume(level.getEnemies().len());
+    });
+
+    pack.close();
+    unlink(path);
+    for (int i = 0; i < 5; i++) {
+        delete builtin[i];
+    }
+}
+
+//!SECTION
+
+// SECTION MAP GENERATOR
+
+static void benchMapGenerator() {
+    Map map;
+    unsigned long long seed = BENCH_SEED;
+
+    // pillars only: gates are connected without carving
+    MapGenerator classic;
+    Bench::run("mapgen/generate/classic", 4096, [&]() {
+        classic.generate(seed++, map);
+        Bench::consume(map.at(1, 1).getType());
+    });
+
+    // no pillars, half the cells solid: connect() carves paths
+    MapGenerator::Params p;
+    p.pillars = false;
+    p.blockPercent = 50;
+    MapGenerator caves(p);
+    Bench::run("mapgen/generate/caves", 4096, [&]() {
+        caves.generate(seed++, map);
+        Bench::consume(map.at(1, 1).getType());
+    });
+}
+
+//!SECTION
+
+// SECTION LEADERBOARD
+
+// rows of the large leaderboard benches, all cabinets together
+static const int LEADERBOARD_ROWS = 1000000;
+
+static void fillLeaderboard(Leaderboard& lb, int rows) {
+    Random rng(BENCH_SEED);
+    char name[4] = {'A', 'A', 'A', '\0'};
+    for (int i = 0; i < rows; i++) {
+        name[0] = (char)('A' + rng.nextInt(0, 25));
+        name[1] = (char)('A' + rng.nextInt(0, 25));
+        name[2] = (char)('A' + rng.nextInt(0, 25));
+        lb.add(name, rng.nextInt(0, 9999999));
+    }
+}
+
+static void benchLeaderboard() {
+    char name[4] = {'A', 'A', 'A', '\0'};
+
+    // a small table from empty, what a new score file gets
+    Bench::run("leaderboard/fill_from_empty/50", 512, [&name]() {
+        Leaderboard lb;
+        Random rng(BENCH_SEED);
+        for (int i = 0; i < 50; i++) {
+            name[0] = (char)('A' + rng.nextInt(0, 25));
+            lb.add(name, rng.nextInt(0, 99999));
+        }
+        Bench::consume((unsigned long long)lb.size());
+    });
+
+    Leaderboard big;
+    fillLeaderboard(big, LEADERBOARD_ROWS);
+    Random rng(BENCH_SEED);
+
+    // every score is kept, the table grows by one per call
+    Bench::run("leaderboard/add/1000000", 8192, [&big, &rng, &name]() {
+        big.add(name, rng.nextInt(0, 9999999));
+    });
+
+    Bench::run("leaderboard/rank_of/1000000", 8192, [&big, &rng]() {
+        Bench::consume((unsigned long long)big.rankOf(
+        rng.nextInt(0, 9999999)));
+    });
+
+    // a leaderboard page anywhere in the table
+    Bench::run("leaderboard/range_5/1000000", 8192, [&big, &rng]() {
+        Leaderboard::ScoreEntry page[5];
+        int n = big.range(rng.nextInt(0, LEADERBOARD_ROWS - 1), 5, page);
+        Bench::consume((unsigned long long)n);
+    });
+
+    Bench::run("leaderboard/best_of/1000000", 8192, [&big, &rng]() {
+        char who[4] = {
+            (char)('A' + rng.nextInt(0, 25)),
+            (char)('A' + rng.nextInt(0, 25)),
+            (char)('A' + rng.nextInt(0, 25)),
+            '\0'
+        };
+        int score = 0;
+        big.bestOf(who, score);
+        Bench::consume((unsigned long long)score);
+    });
+}
+
+static void benchScoreLog() {
+    char path[] = "/tmp/bombergirl_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "scorelog: cannot create temp file, skipped\n");
+        return;
+    }
+    close(fd);
+
+    char logPath[ScoreLog::PATH_SIZE];
+    ScoreLog::logPathOf(path, logPath, sizeof(logPath));
+
+    char name[4] = {'A', 'A', 'A', '\0'};
+    Random rng(BENCH_SEED);
+
+    ScoreLog log;
+    if (!log.open(path, ScoreLog::Sync::NEVER)) {
+        fprintf(stderr, "scorelog: cannot open the log, skipped\n");
+        unlink(path);
+        return;
+    }
+
+    // one write() per score, the disk is left to the system
+    Bench::run("scorelog/append/nosync", 8192, [&log, &rng, &name]() {
+        log.append(name, rng.nextInt(0, 99999));
+    });
+
+    // what a game does at start: the snapshot plus the log
+    // tail, all of the appends above (well before a compaction)
+    Bench::run("scorelog/load/log_tail", 64, [&path]() {
+        Leaderboard lb;
+        lb.load(path);
+        Bench::consume((unsigned long long)lb.size());
+    });
+
+    // the warm-up merges the tail, this is the compactor's check
+    // when no score was added since
+    Bench::run("scorelog/compact/up_to_date", 64, [&log]() {
+        log.compact();
+    });
+
+    log.close();
+    unlink(path);
+    unlink(logPath);
+}
+
+//!SECTION
+
+// SECTION ANSI
+
+static void benchAnsi() {
+    // a 120x40 terminal with a board-like frame in the middle
+    const int W = 120, H = 40;
+    const short palette[9] = {-1, 7, 4, 3, 1, 2, 5, 6, 7};
+
+    Board board(MAP_WIDTH, MAP_HEIGHT);
+    fillBoard(board, BENCH_SEED);
+
+    FrameBuffer frame(W, H);
+    const int ox = (W - MAP_WIDTH * 2) / 2;
+    const int oy = (H - MAP_HEIGHT) / 2;
+    frame.box(oy - 1, ox - 1, MAP_HEIGHT + 2, MAP_WIDTH * 2 + 2, 6);
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            Board::CellType c = board.getCell(
+                (unsigned short)x, (unsigned short)y
+            );
+            char ch = ' ';
+            unsigned char color = 1;
+            if (c == Board::CellType::WALL_SOLID) {
+                ch = '#';
+                color = 2;
+            } else if (c == Board::CellType::WALL_DESTRUCTIBLE) {
+                ch = '+';
+                color = 3;
+            }
+            frame.put(oy + y, ox + x * 2, ch, color);
+            frame.put(oy + y, ox + x * 2 + 1, ch, color);
+        }
+    }
+
+    // encode only, nothing is written
+    AnsiTerminal term(-1);
+    term.setPalette(palette, 9);
+    term.setColors(true);
+
+    Bench::run("ansi/encode/full", 1024, [&]() {
+        term.invalidate();
+        term.encode(frame);
+        Bench::consume(term.size());
+    });
+
+    // eight entities stepping one tile back and forth
+    FrameBuffer moved(W, H);
+    moved.copyFrom(frame);
+    for (int i = 0; i < 8; i++) {
+        int y = oy + 1 + i * 2;
+        int x = ox + 2 + i * 6;
+        moved.put(y, x, 'X', 5);
+        moved.put(y, x + 1, ' ', 5);
+    }
+
+    term.invalidate();
+    term.encode(frame);
+    bool flip = false;
+    Bench::run("ansi/encode/diff_8", 8192, [&]() {
+        term.encode(flip ? frame : moved);
+        flip = !flip;
+        Bench::consume(term.size());
+    });
+}
+
+//!SECTION
+
+// SECTION RENDER
+
+static void benchRender() {
+    // every screen is composed offscreen, no terminal involved
+    FrameBuffer target(120, 40);
+    Render::setTarget(&target);
+
+    Player player;
+    player.reset();
+    Map map = MapBuilder::motherboard();
+    Level level(&player, MAP_WIDTH, MAP_HEIGHT, map);
+    level.onEnter(Level::TransitionRequest::NONE);
+
+    int t = 0;
+    Bench::run("render/compose/game", 4096, [&]() {
+        Render::draw(level.getBoard(), player, level.getEnemies(),
+        level.getBombs(), 300 - (t++ & 63), 1234, 3, 0,
+        level.getPowerUps());
+        Bench::consume((unsigned long long)target.at(20, 60).ch);
+    });
+
+    int step = 0;
+    Bench::run("render/compose/menu", 4096, [&]() {
+        Render::drawMenu(step % 3, step);
+        step++;
+        Bench::consume((unsigned long long)target.at(20, 60).ch);
+    });
+
+    Leaderboard lb;
+    Random rng(BENCH_SEED);
+    char name[4] = {'A', 'A', 'A', '\0'};
+    for (int i = 0; i < 20; i++) {
+        name[0] = (char)('A' + rng.nextInt(0, 25));
+        lb.add(name, rng.nextInt(0, 99999));
+    }
+    int page = 0;
+    Bench::run("render/compose/leaderboard", 4096, [&]() {
+        Render::drawLeaderboard(lb, 20, page++ % 4);
+        Bench::consume((unsigned long long)target.at(20, 60).ch);
+    });
+
+    // the last pages, as deep in the table as it gets
+    Leaderboard big;
+    fillLeaderboard(big, LEADERBOARD_ROWS);
+    const int lastPage = LEADERBOARD_ROWS / 5 - 1;
+    Bench::run("render/compose/leaderboard/1000000", 4096, [&]() {
+        Render::drawLeaderboard(big, LEADERBOARD_ROWS,
+        lastPage - page++ % 4);
+        Bench::consume((unsigned long long)target.at(20, 60).ch);
+    });
+
+    Render::setTarget(nullptr);
+}
+
+//!SECTION
+
+int main(int argc, char** argv) {
+    unsigned warmup = 3;
+    unsigned repeats = 15;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            Bench::setFilter(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeats = (unsigned)atoi(argv[++i]);
+        } else {
+            fprintf(stderr,
+            "usage: %s [--filter TEXT] [--warmup N] [--repeats N]\n",
+            argv[0]);
+            return 1;
+        }
+    }
+
+    Bench::configure(warmup, repeats);
+
+    benchList();
+    benchBoard();
+    benchBomb();
+    benchChaser();
+    benchParser();
+    benchLevelPack();
+    benchMapGenerator();
+    benchLeaderboard();
+    benchScoreLog();
+    benchAnsi();
+    benchRender();
+
+    Bench::printJson(stdout);
+
+    return 0;
+}
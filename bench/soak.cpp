@@ -0,0 +1,317 @@
+/**
+ * @file soak.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief end-to-end soak benchmark entry point (make soak)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file runs the real Level logic with no terminal, driven by
+ * the Autoplayer, for a given amount of simulated game time
+ *
+ * the simulation runs as fast as possible, FPS is only used to
+ * convert simulated minutes into ticks
+ *
+ * usage: bombergirl_soak [--minutes N] [--map builtin|stress]
+ * [--seed N]
+ *
+ * JSON results are written to stdout
+ *
+ */
+
+#include "autoplayer.hpp"
+
+#include "alloc_tracker.hpp"
+#include "level.hpp"
+#include "map_generator.hpp"
+#include "maps.hpp"
+#include "player.hpp"
+#include "profiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+
+// same tick rate as the game
+static const int FPS = 30;
+
+// a level is left after this many simulated seconds
+static const int LEVEL_SECONDS = 60;
+
+static const int LEVEL_COUNT = 5;
+
+/**
+ * @brief returns the generator of the crowded maps used to stress
+ * every subsystem
+ *
+ * classic pillar grid, dense destructible walls and
+ * many enemies of every kind
+ */
+static MapGenerator stressGenerator() {
+    MapGenerator::Params p;
+    p.wallPercent = 40;
+    p.walkers = 24;
+    p.chasers = 12;
+    p.patrollers = 8;
+    p.walkerSpeed = 12;
+    p.chaserSpeed = 8;
+    p.patrollerSpeed = 6;
+    return MapGenerator(p);
+}
+
+/**
+ * @brief returns the peak resident set size in KB
+ */
+static long peakRssKb() {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0){
+        return -1;
+    }
+    return ru.ru_maxrss;
+}
+
+int main(int argc, char** argv) {
+    double minutes = 10.0;
+    bool stress = false;
+    unsigned long long seed = 0xB0BB0ULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--minutes") == 0 && i + 1 < argc) {
+            minutes = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            const char* m = argv[++i];
+            if (strcmp(m, "stress") == 0) {
+                stress = true;
+            } else if (strcmp(m, "builtin") != 0) {
+                fprintf(stderr, "unknown map set: %s\n", m);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--minutes N] "
+            "[--map builtin|stress] [--seed N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (minutes <= 0.0){
+        minutes = 1.0;
+    }
+
+    const unsigned long long totalTicks =
+    (unsigned long long)(minutes * 60.0 * FPS);
+
+    // SECTION SETUP
+
+    static Map maps[LEVEL_COUNT];
+    if (stress) {
+        MapGenerator generator = stressGenerator();
+        for (int i = 0; i < LEVEL_COUNT; i++) {
+            generator.generate(seed + (unsigned long long)i, maps[i]);
+        }
+    } else {
+        maps[0] = MapBuilder::motherboard();
+        maps[1] = MapBuilder::ram();
+        maps[2] = MapBuilder::storage();
+        maps[3] = MapBuilder::cpu();
+        maps[4] = MapBuilder::gpu();
+    }
+
+    Player player;
+    player.reset();
+    player.setLives(4);
+    player.setMaxBombs(1);
+
+    Level* levels[LEVEL_COUNT];
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        levels[i] = new Level(&player, MAP_WIDTH, MAP_HEIGHT, maps[i]);
+    }
+
+    int current = 0;
+    Level* level = levels[current];
+    level->onEnter(Level::TransitionRequest::NONE);
+
+    Autoplayer bot(seed);
+
+    //!SECTION
+
+    unsigned long long bombs = 0;
+    unsigned long long deaths = 0;
+    unsigned long long switches = 0;
+    unsigned long long rebuilds = 0;
+    unsigned long long levelTicks = 0;
+
+    unsigned long long botNs = 0;
+    unsigned long long switchNs = 0;
+
+    Profiler::reset();
+    Profiler::enable(true);
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    for (unsigned long long t = 0; t < totalTicks; t++) {
+        // SECTION TICK
+
+        auto b0 = std::chrono::steady_clock::now();
+        Autoplayer::Action a = bot.decide(*level, player);
+        auto b1 = std::chrono::steady_clock::now();
+        botNs += (unsigned long long)std::chrono::duration_cast<
+        std::chrono::nanoseconds>(b1 - b0).count();
+
+        Profiler::beginTick();
+
+        if (a == Autoplayer::Action::BOMB) {
+            unsigned int before = level->getBombs().len();
+            level->placeBomb();
+            if (level->getBombs().len() > before){
+                bombs++;
+            }
+        } else if (player.canMove()) {
+            if (a == Autoplayer::Action::UP){
+                player.moveUp();
+            } else if (a == Autoplayer::Action::DOWN){
+                player.moveDown();
+            } else if (a == Autoplayer::Action::LEFT){
+                player.moveLeft();
+            } else if (a == Autoplayer::Action::RIGHT){
+                player.moveRight();
+            }
+        }
+
+        level->update();
+        player.updateMovementTimer();
+
+        Profiler::endTick();
+
+        //!SECTION
+
+        // SECTION LEVEL FLOW (not part of the tick cost)
+
+        auto s0 = std::chrono::steady_clock::now();
+
+        if (player.isDead()) {
+            deaths++;
+            player.setLives(4);
+        }
+
+        levelTicks++;
+        Level::TransitionRequest tr = level->getTransitionRequest();
+
+        if (tr != Level::TransitionRequest::NONE ||
+        levelTicks >= (unsigned long long)(LEVEL_SECONDS * FPS)) {
+            int next = (current + 1) % LEVEL_COUNT;
+            Level::TransitionRequest from = Level::TransitionRequest::NEXT;
+            if (tr == Level::TransitionRequest::PREV) {
+                next = (current + LEVEL_COUNT - 1) % LEVEL_COUNT;
+                from = Level::TransitionRequest::PREV;
+            }
+            if (tr == Level::TransitionRequest::NONE){
+                from = Level::TransitionRequest::NONE;
+            }
+
+            level->onExit();
+            level->clearTransitionRequest();
+
+            // a cleared level is reset to keep the load steady
+            if (levels[next]->getEnemies().len() == 0) {
+                levels[next]->reset(maps[next]);
+                rebuilds++;
+            }
+
+            current = next;
+            level = levels[current];
+            player.setMaxBombs(current == 0 ? 1 : (current < 3 ? 2 : 3));
+            level->onEnter(from);
+
+            levelTicks = 0;
+            switches++;
+        }
+
+        auto s1 = std::chrono::steady_clock::now();
+        switchNs += (unsigned long long)std::chrono::duration_cast<
+        std::chrono::nanoseconds>(s1 - s0).count();
+
+        //!SECTION
+    }
+
+    auto wallEnd = std::chrono::steady_clock::now();
+    Profiler::enable(false);
+
+    double wallSec = std::chrono::duration<double>(wallEnd - wallStart)
+    .count();
+    double ticks = (double)totalTicks;
+
+    // SECTION REPORT
+
+    unsigned long long levelNs = 0;
+    for (int p = 0; p < Profiler::PHASE_COUNT; p++) {
+        levelNs += Profiler::total((Profiler::Phase)p);
+    }
+
+    printf("{\n");
+    printf("  \"map_set\": \"%s\",\n", stress ? "stress" : "builtin");
+    printf("  \"seed\": %llu,\n", seed);
+    printf("  \"simulated_minutes\": %.2f,\n", minutes);
+    printf("  \"ticks\": %llu,\n", totalTicks);
+    printf("  \"wall_seconds\": %.4f,\n", wallSec);
+    printf("  \"ticks_per_second\": %.1f,\n",
+    wallSec > 0.0 ? ticks / wallSec : 0.0);
+    printf("  \"realtime_factor\": %.1f,\n",
+    wallSec > 0.0 ? (ticks / FPS) / wallSec : 0.0);
+
+    printf("  \"phases\": [\n");
+    for (int p = 0; p < Profiler::PHASE_COUNT; p++) {
+        Profiler::Phase ph = (Profiler::Phase)p;
+        printf("    {\"name\": \"%s\", \"total_ms\": %.3f, "
+        "\"ns_per_tick\": %.1f},\n",
+        Profiler::name(ph), (double)Profiler::total(ph) / 1e6,
+        (double)Profiler::total(ph) / ticks);
+    }
+    printf("    {\"name\": \"level_update\", \"total_ms\": %.3f, "
+    "\"ns_per_tick\": %.1f},\n", (double)levelNs / 1e6,
+    (double)levelNs / ticks);
+    printf("    {\"name\": \"autoplayer\", \"total_ms\": %.3f, "
+    "\"ns_per_tick\": %.1f},\n", (double)botNs / 1e6,
+    (double)botNs / ticks);
+    printf("    {\"name\": \"level_flow\", \"total_ms\": %.3f, "
+    "\"ns_per_tick\": %.1f}\n", (double)switchNs / 1e6,
+    (double)switchNs / ticks);
+    printf("  ],\n");
+
+    printf("  \"peak_rss_kb\": %ld,\n", peakRssKb());
+    printf("  \"allocations\": {\"total\": %llu, \"per_tick\": %.4f, "
+    "\"bytes_per_tick\": %.2f, \"max_in_one_tick\": %llu},\n",
+    Profiler::tickAllocations(),
+    (double)Profiler::tickAllocations() / ticks,
+    (double)Profiler::tickAllocatedBytes() / ticks,
+    Profiler::maxTickAllocations());
+
+    // whole run, level flow included
+    printf("  \"allocations_by_tag\": [\n");
+    for (int t = 0; t < AllocTracker::TAG_COUNT; t++) {
+        AllocTracker::Tag tag = (AllocTracker::Tag)t;
+        AllocTracker::Stats st = AllocTracker::tagged(tag);
+        printf("    {\"tag\": \"%s\", \"count\": %llu, "
+        "\"bytes\": %llu}%s\n", AllocTracker::name(tag), st.count,
+        st.bytes, t + 1 < AllocTracker::TAG_COUNT ? "," : "");
+    }
+    printf("  ],\n");
+
+    printf("  \"bombs_placed\": %llu,\n", bombs);
+    printf("  \"deaths\": %llu,\n", deaths);
+    printf("  \"level_switches\": %llu,\n", switches);
+    printf("  \"level_rebuilds\": %llu\n", rebuilds);
+    printf("}\n");
+
+    //!SECTION
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        delete levels[i];
+    }
+
+    return 0;
+}
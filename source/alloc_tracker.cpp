@@ -0,0 +1,153 @@
+/**
+ * @file alloc_tracker.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief alloc_tracker.hpp implementation and
+ * global operator new/delete replacement
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "alloc_tracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// process wide counters
+static std::atomic<unsigned long long> g_count(0);
+static std::atomic<unsigned long long> g_bytes(0);
+
+// per tag counters
+static std::atomic<unsigned long long> g_tagCount[AllocTracker::TAG_COUNT];
+static std::atomic<unsigned long long> g_tagBytes[AllocTracker::TAG_COUNT];
+
+// per thread counters and current tag
+// (plain values, no dynamic initialization)
+static thread_local unsigned long long t_count = 0;
+static thread_local unsigned long long t_bytes = 0;
+static thread_local AllocTracker::Tag t_tag = AllocTracker::Tag::UNTAGGED;
+
+void AllocTracker::onAllocate(unsigned long long bytes) {
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    g_tagCount[t_tag].fetch_add(1, std::memory_order_relaxed);
+    g_tagBytes[t_tag].fetch_add(bytes, std::memory_order_relaxed);
+
+    t_count++;
+    t_bytes += bytes;
+}
+
+AllocTracker::Stats AllocTracker::global() {
+    AllocTracker::Stats s;
+    s.count = g_count.load(std::memory_order_relaxed);
+    s.bytes = g_bytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+AllocTracker::Stats AllocTracker::thread() {
+    AllocTracker::Stats s;
+    s.count = t_count;
+    s.bytes = t_bytes;
+    return s;
+}
+
+AllocTracker::Stats AllocTracker::tagged(AllocTracker::Tag t) {
+    AllocTracker::Stats s = {0, 0};
+    if (t < 0 || t >= AllocTracker::TAG_COUNT){
+        return s;
+    }
+    s.count = g_tagCount[t].load(std::memory_order_relaxed);
+    s.bytes = g_tagBytes[t].load(std::memory_order_relaxed);
+    return s;
+}
+
+AllocTracker::Tag AllocTracker::currentTag() {
+    return t_tag;
+}
+
+AllocTracker::Scope::Scope(AllocTracker::Tag t) : previous(t_tag) {
+    t_tag = t;
+}
+
+AllocTracker::Scope::~Scope() {
+    t_tag = this->previous;
+}
+
+const char* AllocTracker::name(AllocTracker::Tag t) {
+    switch (t) {
+        case AllocTracker::Tag::UNTAGGED:
+            return "untagged";
+        case AllocTracker::Tag::LEVEL:
+            return "level";
+        case AllocTracker::Tag::BOARD:
+            return "board";
+        case AllocTracker::Tag::ENEMY:
+            return "enemy";
+        case AllocTracker::Tag::BOMB:
+            return "bomb";
+        case AllocTracker::Tag::POWERUP:
+            return "powerup";
+        case AllocTracker::Tag::PARSER:
+            return "parser";
+        case AllocTracker::Tag::LEADERBOARD:
+            return "leaderboard";
+        default:
+            return "unknown";
+    }
+}
+
+// SECTION OPERATOR NEW / DELETE
+
+void* operator new(std::size_t size) {
+    AllocTracker::onAllocate(size);
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    AllocTracker::onAllocate(size);
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+// kept out of line, once inlined gcc pairs free() with
+// operator new and reports a mismatch
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
+
+//!SECTION
@@ -0,0 +1,100 @@
+/**
+ * @file alloc_tracker.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief global heap allocation accounting
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file declares the AllocTracker class
+ *
+ * alloc_tracker.cpp replaces the global operator new and delete,
+ * so every heap allocation of the program is counted (number of
+ * calls and bytes), both process wide and per thread
+ *
+ * allocations are also grouped by call-site tag: a tag is set
+ * with AllocTracker::Scope around the code that allocates
+ *
+ */
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+/**
+ * @brief static access to the allocation counters
+ */
+class AllocTracker {
+public:
+    /**
+     * @brief call-site tags
+     */
+    enum Tag {
+        UNTAGGED, // nobody set a tag
+        LEVEL, // level construction and load
+        BOARD, // board grids
+        ENEMY, // enemy objects
+        BOMB, // bomb objects
+        POWERUP, // powerup objects
+        PARSER, // bonus file parsing
+        LEADERBOARD, // leaderboard load and save
+        TAG_COUNT // number of tags, not a tag
+    };
+
+    /**
+     * @brief counters snapshot
+     */
+    struct Stats {
+        unsigned long long count; // number of allocations
+        unsigned long long bytes; // requested bytes
+    };
+
+    /**
+     * @brief RAII helper that sets the tag of the current thread
+     *
+     * the previous tag is restored on destruction,
+     * so scopes can be nested
+     */
+    class Scope {
+        private:
+            AllocTracker::Tag previous;
+        public:
+            Scope(AllocTracker::Tag t);
+            ~Scope();
+    };
+
+    /**
+     * @brief process wide counters (every thread)
+     */
+    static AllocTracker::Stats global();
+
+    /**
+     * @brief counters of the calling thread only
+     *
+     * use this to check a code path, other threads
+     * can't change the result
+     */
+    static AllocTracker::Stats thread();
+
+    /**
+     * @brief process wide counters of a single tag
+     */
+    static AllocTracker::Stats tagged(AllocTracker::Tag t);
+
+    /**
+     * @brief returns the current tag of the calling thread
+     */
+    static AllocTracker::Tag currentTag();
+
+    /**
+     * @brief returns a short lowercase name for a tag
+     */
+    static const char* name(AllocTracker::Tag t);
+
+    /**
+     * @brief called by operator new, do not call directly
+     */
+    static void onAllocate(unsigned long long bytes);
+};
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * @file ansi_terminal.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief ansi_terminal.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ansi_terminal.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+// a gap of unchanged cells up to this size is rewritten
+// instead of jumped over (a jump costs at least 3 bytes)
+static const int REWRITE_GAP = 3;
+
+static int digits(int v) {
+    int n = 1;
+    while (v >= 10) {
+        v /= 10;
+        n++;
+    }
+    return n;
+}
+
+AnsiTerminal::AnsiTerminal(int fd) :
+fd(fd), valid(false), cy(-1), cx(-1), curColor(0), curAttr(0),
+sgrKnown(false), colors(false), out(nullptr), outLen(0), outCap(0) {
+    for (int i = 0; i < AnsiTerminal::MAX_PAIRS; i++) {
+        this->palette[i] = -1;
+    }
+}
+
+AnsiTerminal::~AnsiTerminal() {
+    delete[] this->out;
+}
+
+void AnsiTerminal::setPalette(const short* fg, int count) {
+    for (int i = 0; i < AnsiTerminal::MAX_PAIRS; i++) {
+        this->palette[i] = (fg != nullptr && i < count) ? fg[i] : -1;
+    }
+}
+
+void AnsiTerminal::setColors(bool on) {
+    this->colors = on;
+}
+
+void AnsiTerminal::invalidate() {
+    this->valid = false;
+}
+
+const char* AnsiTerminal::data() const {
+    return this->out;
+}
+
+unsigned int AnsiTerminal::size() const {
+    return this->outLen;
+}
+
+// SECTION OUTPUT BUFFER
+
+void AnsiTerminal::append(const char* s, unsigned int n) {
+    if (this->outLen + n > this->outCap) {
+        unsigned int cap = this->outCap == 0 ? 4096 : this->outCap;
+        while (cap < this->outLen + n) {
+            cap *= 2;
+        }
+        char* grown = new char[cap];
+        if (this->outLen > 0){
+            memcpy(grown, this->out, this->outLen);
+        }
+        delete[] this->out;
+        this->out = grown;
+        this->outCap = cap;
+    }
+
+    memcpy(this->out + this->outLen, s, n);
+    this->outLen += n;
+}
+
+void AnsiTerminal::appendChar(char c) {
+    this->append(&c, 1);
+}
+
+void AnsiTerminal::appendNumber(int v) {
+    char tmp[12];
+    int len = 0;
+    do {
+        tmp[len++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+
+    char buf[12];
+    for (int i = 0; i < len; i++) {
+        buf[i] = tmp[len - 1 - i];
+    }
+    this->append(buf, (unsigned int)len);
+}
+
+//!SECTION
+
+// SECTION CURSOR AND STYLE
+
+int AnsiTerminal::csiLen(int n) {
+    // ESC [ C, or ESC [ n C
+    return n == 1 ? 3 : 3 + digits(n);
+}
+
+void AnsiTerminal::moveTo(const FrameBuffer& fb, int y, int x) {
+    if (this->cy == y && this->cx == x){
+        return;
+    }
+
+    const bool known = this->cy >= 0 && this->cx >= 0;
+
+    // short gap on the same row, already in the right style:
+    // the unchanged cells are cheaper to rewrite
+    if (known && this->cy == y && x > this->cx &&
+    x - this->cx <= REWRITE_GAP && this->sgrKnown) {
+        bool sameStyle = true;
+        for (int i = this->cx; i < x; i++) {
+            const FrameBuffer::Cell& c = fb.at(y, i);
+            unsigned char color = this->colors ? c.color : 0;
+            if (color != this->curColor || c.attr != this->curAttr) {
+                sameStyle = false;
+                break;
+            }
+        }
+        if (sameStyle) {
+            for (int i = this->cx; i < x; i++) {
+                this->appendChar(fb.at(y, i).ch);
+            }
+            this->cx = x;
+            return;
+        }
+    }
+
+    // absolute: ESC [ row ; col H (col omitted when 1)
+    int cupLen = x == 0 ? 3 + digits(y + 1)
+    : 4 + digits(y + 1) + digits(x + 1);
+
+    // relative: vertical step, then CR and/or horizontal step
+    int relLen = -1;
+    bool useCr = false;
+    if (known) {
+        int dy = y - this->cy;
+        relLen = dy == 0 ? 0 : AnsiTerminal::csiLen(dy < 0 ? -dy : dy);
+
+        int dx = x - this->cx;
+        int horLen = dx == 0 ? 0 : AnsiTerminal::csiLen(dx < 0 ? -dx : dx);
+        int crLen = 1 + (x == 0 ? 0 : AnsiTerminal::csiLen(x));
+        if (crLen < horLen) {
+            useCr = true;
+            horLen = crLen;
+        }
+        relLen += horLen;
+    }
+
+    if (relLen < 0 || cupLen <= relLen) {
+        this->append("\x1b[", 2);
+        this->appendNumber(y + 1);
+        if (x != 0) {
+            this->appendChar(';');
+            this->appendNumber(x + 1);
+        }
+        this->appendChar('H');
+    } else {
+        int dy = y - this->cy;
+        if (dy != 0) {
+            int n = dy < 0 ? -dy : dy;
+            this->append("\x1b[", 2);
+            if (n != 1){
+                this->appendNumber(n);
+            }
+            this->appendChar(dy < 0 ? 'A' : 'B');
+        }
+
+        int from = this->cx;
+        if (useCr) {
+            this->appendChar('\r');
+            from = 0;
+        }
+        int dx = x - from;
+        if (dx != 0) {
+            int n = dx < 0 ? -dx : dx;
+            this->append("\x1b[", 2);
+            if (n != 1){
+                this->appendNumber(n);
+            }
+            this->appendChar(dx < 0 ? 'D' : 'C');
+        }
+    }
+
+    this->cy = y;
+    this->cx = x;
+}
+
+void AnsiTerminal::setStyle(const FrameBuffer::Cell& c) {
+    unsigned char color = this->colors ? c.color : 0;
+    unsigned char attr = c.attr;
+
+    if (this->sgrKnown && color == this->curColor && attr == this->curAttr){
+        return;
+    }
+
+    this->append("\x1b[", 2);
+
+    bool first = true;
+    unsigned char addFlags;
+    bool needColor;
+
+    // attributes can only be removed with a full reset
+    if (!this->sgrKnown || (this->curAttr & ~attr) != 0) {
+        this->appendChar('0');
+        first = false;
+        addFlags = attr;
+        needColor = color != 0;
+    } else {
+        addFlags = (unsigned char)(attr & ~this->curAttr);
+        needColor = color != this->curColor;
+    }
+
+    const unsigned char flags[3] = {
+        FrameBuffer::BOLD, FrameBuffer::DIM, FrameBuffer::REVERSE
+    };
+    const char codes[3] = {'1', '2', '7'};
+
+    for (int i = 0; i < 3; i++) {
+        if (addFlags & flags[i]) {
+            if (!first){
+                this->appendChar(';');
+            }
+            this->appendChar(codes[i]);
+            first = false;
+        }
+    }
+
+    if (needColor) {
+        if (!first){
+            this->appendChar(';');
+        }
+        short fg = color < AnsiTerminal::MAX_PAIRS ? this->palette[color] : -1;
+        // 30..37, 39 = default foreground
+        this->appendChar('3');
+        this->appendChar(fg >= 0 && fg <= 7 ? (char)('0' + fg) : '9');
+    }
+
+    this->appendChar('m');
+
+    this->curColor = color;
+    this->curAttr = attr;
+    this->sgrKnown = true;
+}
+
+//!SECTION
+
+// SECTION FRAMES
+
+void AnsiTerminal::encode(const FrameBuffer& fb) {
+    this->outLen = 0;
+
+    const int h = fb.height();
+    const int w = fb.width();
+
+    if (!this->valid || this->model.width() != w ||
+    this->model.height() != h) {
+        // reset style, home, clear screen
+        this->append("\x1b[0m\x1b[H\x1b[2J", 11);
+        this->model.resize(w, h);
+        this->cy = 0;
+        this->cx = 0;
+        this->curColor = 0;
+        this->curAttr = 0;
+        this->sgrKnown = true;
+        this->valid = true;
+    }
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const FrameBuffer::Cell& c = fb.at(y, x);
+            if (c == this->model.at(y, x)){
+                continue;
+            }
+
+            this->moveTo(fb, y, x);
+            this->setStyle(c);
+            this->appendChar(c.ch);
+            this->model.put(y, x, c.ch, c.color, c.attr);
+
+            this->cx++;
+            if (this->cx >= w) {
+                // pending wrap, position depends on the terminal
+                this->cx = -1;
+                this->cy = -1;
+            }
+        }
+    }
+}
+
+long AnsiTerminal::present(const FrameBuffer& fb) {
+    this->encode(fb);
+
+    unsigned int done = 0;
+    while (done < this->outLen) {
+        ssize_t n = write(this->fd, this->out + done, this->outLen - done);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN){
+                continue;
+            }
+            // unknown screen state, start over next frame
+            this->valid = false;
+            return -1;
+        }
+        done += (unsigned int)n;
+    }
+
+    return (long)done;
+}
+
+void AnsiTerminal::release() {
+    if (!this->sgrKnown || this->curColor != 0 || this->curAttr != 0) {
+        ssize_t n = write(this->fd, "\x1b[0m", 4);
+        (void)n;
+    }
+    this->curColor = 0;
+    this->curAttr = 0;
+    this->sgrKnown = true;
+    this->cy = -1;
+    this->cx = -1;
+}
+
+//!SECTION
@@ -0,0 +1,146 @@
+/**
+ * @file ansi_terminal.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief raw ANSI output backend for game frames
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the AnsiTerminal class, an alternative to
+ * ncurses output for the game screen
+ *
+ * the terminal keeps a model of what is on screen, encodes the
+ * difference with a new FrameBuffer as cursor movements, SGR
+ * sequences and characters, and sends the whole frame with a
+ * single write()
+ *
+ * ncurses is still used for input and for every other screen
+ *
+ */
+
+#ifndef ANSI_TERMINAL_HPP
+#define ANSI_TERMINAL_HPP
+
+#include "framebuffer.hpp"
+
+/**
+ * @brief ANSI/VT100 frame encoder and writer
+ */
+class AnsiTerminal {
+public:
+    /**
+     * @brief max number of color pairs in the palette
+     */
+    static const int MAX_PAIRS = 16;
+
+private:
+    // output file descriptor
+    int fd;
+
+    // what the terminal shows
+    FrameBuffer model;
+    bool valid;
+
+    // cursor position, -1 when unknown
+    int cy, cx;
+
+    // current SGR state
+    unsigned char curColor, curAttr;
+    bool sgrKnown;
+
+    // pair -> ansi foreground (0..7, -1 = default)
+    short palette[AnsiTerminal::MAX_PAIRS];
+    bool colors;
+
+    // bytes of the frame being encoded
+    char* out;
+    unsigned int outLen, outCap;
+
+    void append(const char* s, unsigned int n);
+    void appendChar(char c);
+    void appendNumber(int v);
+
+    /**
+     * @brief moves the cursor to (y,x) with the shortest sequence
+     *
+     * fb is the frame being encoded, used to rewrite short
+     * unchanged gaps instead of jumping over them
+     */
+    void moveTo(const FrameBuffer& fb, int y, int x);
+
+    /**
+     * @brief switches the SGR state to the style of c
+     */
+    void setStyle(const FrameBuffer::Cell& c);
+
+    /**
+     * @brief returns the length of the CSI sequence for n
+     */
+    static int csiLen(int n);
+
+public:
+    /**
+     * @brief creates a terminal writing on fd
+     */
+    AnsiTerminal(int fd);
+
+    ~AnsiTerminal();
+
+    AnsiTerminal(const AnsiTerminal&) = delete;
+    AnsiTerminal& operator=(const AnsiTerminal&) = delete;
+
+    /**
+     * @brief sets the color pair palette
+     *
+     * @param fg foreground of each pair (ansi 0..7, -1 = default)
+     * @param count number of pairs, at most MAX_PAIRS
+     */
+    void setPalette(const short* fg, int count);
+
+    /**
+     * @brief enables or disables color sequences
+     */
+    void setColors(bool on);
+
+    /**
+     * @brief forgets the screen model
+     *
+     * the next frame clears the screen and is sent in full
+     */
+    void invalidate();
+
+    /**
+     * @brief encodes the difference between the model and fb
+     *
+     * the bytes are available with data() and size() until the
+     * next encode, the model becomes fb
+     */
+    void encode(const FrameBuffer& fb);
+
+    /**
+     * @brief bytes of the last encoded frame
+     */
+    const char* data() const;
+
+    /**
+     * @brief number of bytes of the last encoded frame
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief encodes fb and sends it with one write()
+     *
+     * @return number of bytes written, -1 on write error
+     */
+    long present(const FrameBuffer& fb);
+
+    /**
+     * @brief resets the SGR state of the real terminal
+     *
+     * call this before another library writes to the terminal
+     */
+    void release();
+};
+
+#endif
@@ -10,10 +10,30 @@
  */
 
 #include "board.hpp"
+#include "alloc_tracker.hpp"
 
-Board::Board() : width(0), height(0), grid(nullptr) { }
+#include <atomic>
+
+// source of layout revisions, boards can be built on any thread
+static std::atomic<unsigned long> g_layoutRevisions(0);
+
+void Board::bumpLayout() {
+    this->layoutRevision = ++g_layoutRevisions;
+}
+
+unsigned long Board::getLayoutRevision() const {
+    return this->layoutRevision;
+}
+
+Board::Board() : width(0), height(0), grid(nullptr) {
+    this->bumpLayout();
+}
 
 Board::Board(unsigned short w, unsigned short h) : width(w), height(h) {
+    AllocTracker::Scope tag(AllocTracker::Tag::BOARD);
+
+    this->bumpLayout();
+
     this->grid = new Board::CellType*[this->height];
     this->explosionTtl = new unsigned short*[this->height];
     for (unsigned short y = 0; y < this->height; y++) {
@@ -41,6 +61,7 @@ void Board::clear(){
             this->grid[y][x] = Board::CellType::EMPTY;
         }
     } 
+    this->bumpLayout();
 }
 
 void Board::setCell(unsigned short x, unsigned short y,
@@ -51,6 +72,11 @@ Board::CellType type){
     if (x >= this->width || y >= this->height) {
         throw Board::BoardOutOfBoundsException();
     }
+    if ((this->grid[y][x] == Board::CellType::WALL_SOLID) !=
+    (type == Board::CellType::WALL_SOLID)) {
+        this->bumpLayout();
+    }
+
     this->grid[y][x] = type;
 
     if (type == Board::CellType::EXPLOSION) {
@@ -90,6 +90,15 @@ private:
     // explosion effects time to live (ticks)
     unsigned short** explosionTtl;
 
+    // changes every time the solid walls change, unique
+    // across all boards (see getLayoutRevision())
+    unsigned long layoutRevision;
+
+    /**
+     * @brief gives the board a new layout revision
+     */
+    void bumpLayout();
+
 public:
     /**
      * @brief default constructor, creates
@@ -144,6 +153,16 @@ public:
      */
     Board::CellType getCell(unsigned short x,
     unsigned short y) const;
+    /**
+     * @brief returns the revision of the solid wall layout
+     *
+     * the value changes whenever a solid wall is placed or removed
+     * (and on clear()), two boards never share a revision, so
+     * renderers can cache the static part of a board and rebuild
+     * it only when the revision changes
+     */
+    unsigned long getLayoutRevision() const;
+
     /**
      * @brief returns the board width
      * @return width in cells
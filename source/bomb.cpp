@@ -11,7 +11,8 @@
 
 #include "bomb.hpp"
 
-void Bomb::update(list<Enemy*>& el, list<PowerUp*>& powerups, Random& rng) {
+void Bomb::update(list<Enemy*>& el, EnemyPool& enemyStorage,
+list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng) {
     if (!this->placed){
         return;
     } 
@@ -21,7 +22,7 @@ void Bomb::update(list<Enemy*>& el, list<PowerUp*>& powerups, Random& rng) {
     }
 
     if (this->timer == 0) {
-        this->explode(el, powerups, rng);
+        this->explode(el, enemyStorage, powerups, storage, rng);
     }
 }
 
@@ -43,8 +44,8 @@ bool Bomb::isPlaced() const{
     return this->placed;
 }
 
-void Bomb::explode(list<Enemy*>& el, 
-list<PowerUp*>& powerups, Random& rng) {
+void Bomb::explode(list<Enemy*>& el, EnemyPool& enemyStorage,
+list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng) {
     if (this->placed == false){
         return;
     }
@@ -84,7 +85,7 @@ list<PowerUp*>& powerups, Random& rng) {
                     Enemy* e = el.at(i);
                     if(e->getX() == nx && e->getY() == ny){
                         this->owner->addScore(e->scoreValue());
-                        delete e;
+                        enemyStorage.destroy(e);
                         el.remove(i);
                         break;
                     }
@@ -92,7 +93,7 @@ list<PowerUp*>& powerups, Random& rng) {
 
                 if (cell == Board::CellType::WALL_DESTRUCTIBLE) {
                     this->owner->addScore(10);
-                    if(!this->trySpawnPowerUp(nx,ny,powerups,rng)){
+                    if(!this->trySpawnPowerUp(nx,ny,powerups,storage,rng)){
                         this->board->setCell(
                             nx,
                             ny,
@@ -136,7 +137,7 @@ unsigned short Bomb::getY() const {
 }
 
 bool Bomb::trySpawnPowerUp(unsigned short x, unsigned short y,
-list<PowerUp*>& powerups, Random& rng) {
+list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng) {
     // avoid double spawn in the same tile
     for (unsigned int i = 0; i < powerups.len(); i++) {
         PowerUp* p = powerups.at(i);
@@ -151,13 +152,13 @@ list<PowerUp*>& powerups, Random& rng) {
     if (roll <= 880) {
         return false;
     } else if (roll <= 928) {
-        p = new SpeedUp(x, y, 600, 180);
+        p = storage.create<SpeedUp>(x, y, 600, 180);
     } else if (roll <= 964) {
-        p = new Gunpowder(x, y, 600, 300);
+        p = storage.create<Gunpowder>(x, y, 600, 300);
     } else if (roll <= 994) {
-        p = new ScoreUp(x, y, 600, 250);
+        p = storage.create<ScoreUp>(x, y, 600, 250);
     } else {
-        p = new Star(x, y, 600, 90);
+        p = storage.create<Star>(x, y, 600, 90);
     }
 
     if (p) {
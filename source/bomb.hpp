@@ -24,6 +24,7 @@
 #include "enemies.hpp"
 #include "random.hpp"
 #include "powerup.hpp"
+#include "pool.hpp"
 
 /**
  * @brief special coordinate value used to mark an
@@ -112,11 +113,13 @@ private:
      * @param y y coordinate.
      * @param powerups list where the new PowerUp 
      * will be added if spawned
+     * @param storage pool the new PowerUp is built in
+     * (no drop when the pool is full)
      * @param rng random generator used to roll spawn chances
      * @return true if a powerup was spawned, false otherwise
      */
     bool trySpawnPowerUp(unsigned short x, unsigned short y,
-    list<PowerUp*>& powerups, Random& rng);
+    list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng);
 
 public:
     /**
@@ -142,11 +145,13 @@ public:
      * if timer reaches 0
      *
      * @param el enemy list, used to kill enemies 
+     * @param enemyStorage pool the enemies live in
      * @param powerups powerup list, used to spawn new powerups
+     * @param storage pool new powerups are built in
      * @param rng random generator used for powerup spawning
      */
-    void update(list<Enemy*>& el, list<PowerUp*>& powerups,
-    Random& rng);
+    void update(list<Enemy*>& el, EnemyPool& enemyStorage,
+    list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng);
 
     /**
      * @brief the bomb explodes, applying damage and board changes.
@@ -154,12 +159,14 @@ public:
      * after exploding, the bomb is marked as not placed
      * and its coordinates become BOMB_INVALID
      *
-     * @param el enemy list, enemies that are hit are removed and deleted
+     * @param el enemy list, enemies that are hit are removed and destroyed
+     * @param enemyStorage pool the enemies live in
      * @param powerups powerup list, new powerups may be spawned
+     * @param storage pool new powerups are built in
      * @param rng random generator used for powerup spawning
      */
-    void explode(list<Enemy*>& el, list<PowerUp*>& powerups,
-    Random& rng);
+    void explode(list<Enemy*>& el, EnemyPool& enemyStorage,
+    list<PowerUp*>& powerups, PowerUpPool& storage, Random& rng);
 
     /**
      * @brief returns whether this bomb is 
@@ -183,4 +190,17 @@ public:
     ~Bomb() = default;
 };
 
+/**
+ * @brief max number of bombs on the board of a level
+ *
+ * the player can't hold more than 3 bombs, 8 leaves room
+ * for debug tweaks
+ */
+#define MAX_BOMBS 8
+
+/**
+ * @brief storage for the bombs of a level
+ */
+typedef pool<Bomb, MAX_BOMBS> BombPool;
+
 #endif
@@ -0,0 +1,284 @@
+/**
+ * @file bonus_pack.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief bonus_pack.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "bonus_pack.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+static const char HEADER_NAME[] = "@level";
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* skipSpaces(const char* q, const char* end) {
+    while (q < end && isSpace(*q)){
+        q++;
+    }
+    return q;
+}
+
+static bool atLineEnd(const char* q, const char* end) {
+    return q == end || *q == '\n';
+}
+
+static const char* nextLine(const char* q, const char* end) {
+    const char* eol = (const char*)memchr(q, '\n', (std::size_t)(end - q));
+    return eol != nullptr ? eol + 1 : end;
+}
+
+/**
+ * @brief reads ";number" of a header, spaces allowed around it
+ *
+ * @param at set to the wrong character on failure
+ * @return nullptr on success, else the error message
+ */
+static const char* headerField(const char*& q, const char* end,
+unsigned short max, unsigned short& value, const char*& at) {
+    q = skipSpaces(q, end);
+    at = q;
+    if (atLineEnd(q, end) || *q != ';'){
+        return "expected @level;width;height";
+    }
+    q = skipSpaces(q + 1, end);
+    at = q;
+
+    unsigned int v = 0;
+    std::from_chars_result r = std::from_chars(q, end, v);
+    if (r.ec != std::errc() && r.ec != std::errc::result_out_of_range){
+        return "not a number";
+    }
+    if (r.ec != std::errc() || v < BonusPack::MIN_SIZE || v > max){
+        return "level size out of range";
+    }
+
+    value = (unsigned short)v;
+    q = r.ptr;
+    return nullptr;
+}
+
+BonusPack::BonusPack() :
+data(nullptr), size(0), mapped(false), multi(false),
+starts(nullptr), known(0), capacity(0), complete(false) {}
+
+BonusPack::~BonusPack() {
+    this->close();
+}
+
+void BonusPack::addStart(std::size_t offset, int line, bool header) {
+    if (this->known == this->capacity) {
+        int grown = this->capacity > 0 ? this->capacity * 2 : 16;
+        BonusPack::Start* s = new BonusPack::Start[grown];
+        for (int i = 0; i < this->known; i++) {
+            s[i] = this->starts[i];
+        }
+        delete[] this->starts;
+        this->starts = s;
+        this->capacity = grown;
+    }
+
+    BonusPack::Start& s = this->starts[this->known++];
+    s.begin = offset;
+    s.offset = offset;
+    s.line = line;
+    s.width = MAP_WIDTH;
+    s.height = MAP_HEIGHT;
+    s.error = nullptr;
+    s.column = 0;
+
+    if (!header){
+        return;
+    }
+
+    // the level starts on the line after its header
+    const char* end = this->data + this->size;
+    const char* lineStart = this->data + offset;
+    s.offset = (std::size_t)(nextLine(lineStart, end) - this->data);
+    s.line = line + 1;
+    this->multi = true;
+
+    const char* q = skipSpaces(lineStart, end);
+    const char* at = q;
+    const std::size_t nameLength = sizeof(HEADER_NAME) - 1;
+    if ((std::size_t)(end - q) < nameLength ||
+    memcmp(q, HEADER_NAME, nameLength) != 0) {
+        s.error = "unknown header, expected @level;width;height";
+    } else {
+        q += nameLength;
+        s.error = headerField(q, end, MAP_WIDTH, s.width, at);
+        if (s.error == nullptr){
+            s.error = headerField(q, end, MAP_HEIGHT, s.height, at);
+        }
+        if (s.error == nullptr) {
+            q = skipSpaces(q, end);
+            at = q;
+            if (!atLineEnd(q, end)){
+                s.error = "unexpected character after the header";
+            }
+        }
+    }
+    s.column = (int)(at - lineStart) + 1;
+}
+
+void BonusPack::findNext() {
+    const BonusPack::Start& last = this->starts[this->known - 1];
+    const char* end = this->data + this->size;
+    const char* p = this->data + last.offset;
+    int line = last.line;
+
+    for (; p < end; line++) {
+        const char* s = skipSpaces(p, end);
+        if (s < end && *s == '@') {
+            this->addStart((std::size_t)(p - this->data), line, true);
+            return;
+        }
+        p = nextLine(s, end);
+    }
+
+    this->complete = true;
+}
+
+bool BonusPack::open(const char* path, Parser::Diagnostics* diag) {
+    this->close();
+    if (diag != nullptr) {
+        diag->count = 0;
+        diag->total = 0;
+    }
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        Parser::addError(diag, 0, 0, "cannot open the bonus file");
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        Parser::addError(diag, 0, 0, "cannot read the bonus file");
+        return false;
+    }
+
+    // an empty file can't be mapped, it is a level without tiles
+    this->data = "";
+    this->size = 0;
+    if (st.st_size > 0) {
+        void* p = mmap(nullptr, (std::size_t)st.st_size, PROT_READ,
+        MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            this->data = nullptr;
+            Parser::addError(diag, 0, 0, "cannot read the bonus file");
+            return false;
+        }
+        this->data = (const char*)p;
+        this->size = (std::size_t)st.st_size;
+        this->mapped = true;
+        madvise(p, this->size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+
+    // a header as the first line that isn't blank or a comment
+    // makes every level explicit, else the first one is full size
+    const char* end = this->data + this->size;
+    const char* p = this->data;
+    int line = 1;
+    for (; p < end; line++) {
+        const char* s = skipSpaces(p, end);
+        if (!atLineEnd(s, end) && *s != '#') {
+            break;
+        }
+        p = nextLine(s, end);
+    }
+
+    const char* first = skipSpaces(p, end);
+    if (first < end && *first == '@') {
+        this->addStart((std::size_t)(p - this->data), line, true);
+    } else {
+        this->addStart(0, 1, false);
+    }
+    return true;
+}
+
+void BonusPack::close() {
+    if (this->mapped){
+        munmap((void*)this->data, this->size);
+    }
+    this->data = nullptr;
+    this->size = 0;
+    this->mapped = false;
+    this->multi = false;
+
+    delete[] this->starts;
+    this->starts = nullptr;
+    this->known = 0;
+    this->capacity = 0;
+    this->complete = false;
+}
+
+void BonusPack::swap(BonusPack& other) {
+    std::swap(this->data, other.data);
+    std::swap(this->size, other.size);
+    std::swap(this->mapped, other.mapped);
+    std::swap(this->multi, other.multi);
+    std::swap(this->starts, other.starts);
+    std::swap(this->known, other.known);
+    std::swap(this->capacity, other.capacity);
+    std::swap(this->complete, other.complete);
+}
+
+bool BonusPack::isMultiLevel() const {
+    return this->multi;
+}
+
+BonusPack::Result BonusPack::read(int index, Map& out,
+Parser::Diagnostics* diag) {
+    if (diag != nullptr) {
+        diag->count = 0;
+        diag->total = 0;
+    }
+    if (this->data == nullptr || index < 0){
+        return BonusPack::Result::END;
+    }
+
+    // the next start is where this level ends
+    while (!this->complete && this->known <= index + 1){
+        this->findNext();
+    }
+    if (index >= this->known){
+        return BonusPack::Result::END;
+    }
+
+    const BonusPack::Start& s = this->starts[index];
+    if (s.error != nullptr) {
+        Parser::addError(diag, s.line - 1, s.column, s.error);
+        return BonusPack::Result::FAILED;
+    }
+
+    std::size_t end = this->size;
+    if (index + 1 < this->known){
+        end = this->starts[index + 1].begin;
+    }
+    if (end < s.offset){
+        end = s.offset;
+    }
+
+    if (Parser::parseLevel(this->data + s.offset, end - s.offset, s.width,
+    s.height, s.line, out, diag)) {
+        return BonusPack::Result::LEVEL;
+    }
+    return BonusPack::Result::FAILED;
+}
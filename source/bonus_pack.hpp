@@ -0,0 +1,141 @@
+/**
+ * @file bonus_pack.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief multi-level bonus file, read one level at a time
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the BonusPack class, which reads bonus files
+ * holding many levels (the Parser format, split by level headers)
+ *
+ * a level starts with a header line:
+ *   `@level;width;height`
+ * followed by its tiles, up to the next header or the end of the
+ * file; a file without headers is a single full size level
+ *
+ * the file is mapped, never copied: open() only finds the first
+ * level and every read() parses one level and finds the next, so
+ * the cost of a read doesn't depend on the size of the file
+ *
+ */
+
+#ifndef BONUS_PACK_HPP
+#define BONUS_PACK_HPP
+
+#include "maps.hpp"
+#include "parser.hpp"
+
+#include <cstddef>
+
+/**
+ * @brief a bonus file of one or more levels, read on demand
+ *
+ * not thread safe: one call at a time, from any thread
+ */
+class BonusPack {
+public:
+    /**
+     * @brief smallest level side, border included
+     */
+    static const unsigned short MIN_SIZE = 5;
+
+    /**
+     * @brief what read() found
+     */
+    enum Result {
+        LEVEL,  // the level is in the map
+        END,    // the file has fewer levels
+        FAILED  // the level has errors, see the diagnostics
+    };
+
+private:
+    /**
+     * @brief where a level starts in the file
+     */
+    struct Start {
+        std::size_t begin;  // first byte of the header line
+        std::size_t offset; // first byte after the header line
+        int line;           // line number of offset
+        unsigned short width, height;
+
+        // header error (nullptr if none) and its column
+        const char* error;
+        int column;
+    };
+
+    const char* data;
+    std::size_t size;
+    bool mapped;
+
+    // true if the file has level headers
+    bool multi;
+
+    // levels found so far, grown by read()
+    BonusPack::Start* starts;
+    int known;
+    int capacity;
+
+    // true once the last level has been found
+    bool complete;
+
+    /**
+     * @brief adds a level start, parsing the header line at offset
+     * (or a full size level if header is false)
+     */
+    void addStart(std::size_t offset, int line, bool header);
+
+    /**
+     * @brief finds the start of the level after the last known one
+     */
+    void findNext();
+
+public:
+    BonusPack();
+
+    /**
+     * @brief unmaps the file if it is open
+     */
+    ~BonusPack();
+
+    // the starts point into the mapping
+    BonusPack(const BonusPack&) = delete;
+    BonusPack& operator=(const BonusPack&) = delete;
+
+    /**
+     * @brief maps a bonus file and finds its first level
+     *
+     * @param diag error list, can be null
+     * @return false if the file can't be read
+     */
+    bool open(const char* path, Parser::Diagnostics* diag);
+
+    /**
+     * @brief unmaps the file
+     */
+    void close();
+
+    /**
+     * @brief exchanges the files of two packs (a reloaded file
+     * replaces the one in use)
+     */
+    void swap(BonusPack& other);
+
+    /**
+     * @brief returns true if the file has level headers
+     */
+    bool isMultiLevel() const;
+
+    /**
+     * @brief parses the level at index into out
+     *
+     * levels are found in order, reading a level also finds where
+     * the next one starts; errors have file line numbers
+     *
+     * @param diag error list, can be null
+     */
+    BonusPack::Result read(int index, Map& out, Parser::Diagnostics* diag);
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include "board.hpp"
 #include "player.hpp"
 #include "random.hpp"
+#include "pool.hpp"
 #include <exception>
 
 /**
@@ -326,13 +327,6 @@ private:
     unsigned short wanderHold;
     unsigned short wanderHoldLeft;
 
-    /**
-     * @brief returns true if the chaser can 
-     * see the player 
-     * @param maxRange max range to test
-     */
-    bool seesPlayer(unsigned short maxRange) const;
-
     /**
      * @brief returns true if the chaser sees 
      * the player on the same row
@@ -400,6 +394,13 @@ public:
      */
     void update() override;
 
+    /**
+     * @brief returns true if the chaser can 
+     * see the player 
+     * @param maxRange max range to test
+     */
+    bool seesPlayer(unsigned short maxRange) const;
+
     /**
      * @brief Returns Enemy::Kind::CHASER
      */
@@ -412,4 +413,24 @@ public:
     
 };
 
+/**
+ * @brief max number of enemies kept in the pool of a level
+ *
+ * maps with more enemies (bonus files) put the rest on the heap
+ */
+#define MAX_ENEMIES 32
+
+/**
+ * @brief size of a slot of the enemy pool, the largest enemy
+ */
+static constexpr std::size_t ENEMY_SLOT =
+sizeof(Walker) > sizeof(Patroller) ?
+(sizeof(Walker) > sizeof(Chaser) ? sizeof(Walker) : sizeof(Chaser)) :
+(sizeof(Patroller) > sizeof(Chaser) ? sizeof(Patroller) : sizeof(Chaser));
+
+/**
+ * @brief storage for the enemies of a level
+ */
+typedef pool<Enemy, MAX_ENEMIES, ENEMY_SLOT> EnemyPool;
+
 #endif
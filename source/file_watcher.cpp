@@ -0,0 +1,112 @@
+/**
+ * @file file_watcher.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief file_watcher.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "file_watcher.hpp"
+
+#include <cstring>
+#include <limits.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// a save ends with one of these on the file name: a close after
+// writing, or a rename over it
+static const unsigned int WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+FileWatcher::FileWatcher() : fd(-1), watch(-1) {
+    this->name[0] = '\0';
+}
+
+FileWatcher::~FileWatcher() {
+    this->close();
+}
+
+bool FileWatcher::open(const char* path) {
+    this->close();
+
+    const char* slash = strrchr(path, '/');
+    const char* file = slash != nullptr ? slash + 1 : path;
+    if (strlen(file) >= (std::size_t)FileWatcher::NAME_SIZE ||
+    file[0] == '\0'){
+        return false;
+    }
+
+    // the directory part, "." for a bare name
+    char dir[PATH_MAX];
+    if (slash == nullptr) {
+        strcpy(dir, ".");
+    } else if (slash == path) {
+        strcpy(dir, "/");
+    } else {
+        const std::size_t length = (std::size_t)(slash - path);
+        if (length >= sizeof(dir)){
+            return false;
+        }
+        memcpy(dir, path, length);
+        dir[length] = '\0';
+    }
+
+    this->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->fd < 0){
+        return false;
+    }
+
+    this->watch = inotify_add_watch(this->fd, dir, WATCH_EVENTS);
+    if (this->watch < 0) {
+        this->close();
+        return false;
+    }
+
+    strcpy(this->name, file);
+    return true;
+}
+
+void FileWatcher::close() {
+    if (this->fd >= 0){
+        // closing the instance removes its watches
+        ::close(this->fd);
+    }
+    this->fd = -1;
+    this->watch = -1;
+    this->name[0] = '\0';
+}
+
+bool FileWatcher::isOpen() const {
+    return this->fd >= 0;
+}
+
+bool FileWatcher::changed() {
+    if (this->fd < 0){
+        return false;
+    }
+
+    bool hit = false;
+
+    // events are variable length, the buffer holds many of them
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t n = read(this->fd, buffer, sizeof(buffer));
+        if (n <= 0){
+            break; // EAGAIN: nothing left
+        }
+
+        for (ssize_t at = 0; at < n; ) {
+            const struct inotify_event* e =
+            (const struct inotify_event*)(buffer + at);
+            if (e->len > 0 && (e->mask & WATCH_EVENTS) != 0 &&
+            strcmp(e->name, this->name) == 0){
+                hit = true;
+            }
+            at += (ssize_t)(sizeof(struct inotify_event) + e->len);
+        }
+    }
+
+    return hit;
+}
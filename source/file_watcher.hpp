@@ -0,0 +1,80 @@
+/**
+ * @file file_watcher.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief change notifications for a file, through inotify
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the FileWatcher class, used by bonus mode to
+ * reload the level file while it is edited (bombergirl --watch)
+ *
+ * the directory of the file is watched, not the file itself:
+ * editors often save by writing a new file and renaming it over
+ * the old one, which a watch on the old inode would miss
+ *
+ */
+
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+/**
+ * @brief reports when a file is written or replaced
+ *
+ * changed() never blocks, it is meant to be called once per tick
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief longest file name watched, terminator included
+     */
+    static const int NAME_SIZE = 256;
+
+private:
+    int fd;     // inotify instance, -1 if closed
+    int watch;  // watch descriptor of the directory
+
+    // file name inside the watched directory
+    char name[FileWatcher::NAME_SIZE];
+
+public:
+    FileWatcher();
+
+    /**
+     * @brief stops watching
+     */
+    ~FileWatcher();
+
+    // the descriptor would be closed twice
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief starts watching path, the file doesn't need to exist
+     *
+     * @return false if inotify is not available or the directory
+     * can't be watched
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief stops watching
+     */
+    void close();
+
+    /**
+     * @brief returns true between a successful open() and close()
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief returns true if the file was written (and closed) or
+     * replaced since the last call
+     *
+     * reads every pending event, many writes give a single true
+     */
+    bool changed();
+};
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file framebuffer.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief framebuffer.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "framebuffer.hpp"
+
+FrameBuffer::FrameBuffer() : cells(nullptr), w(0), h(0) { }
+
+FrameBuffer::FrameBuffer(int width, int height) :
+cells(nullptr), w(0), h(0) {
+    this->resize(width, height);
+}
+
+FrameBuffer::~FrameBuffer() {
+    delete[] this->cells;
+}
+
+FrameBuffer::Cell FrameBuffer::blank() {
+    FrameBuffer::Cell c;
+    c.ch = ' ';
+    c.color = 0;
+    c.attr = FrameBuffer::NORMAL;
+    return c;
+}
+
+void FrameBuffer::resize(int width, int height) {
+    if (width < 0 || height < 0){
+        throw FrameBuffer::InvalidSizeException();
+    }
+
+    if (width != this->w || height != this->h) {
+        delete[] this->cells;
+        this->cells = nullptr;
+        this->w = width;
+        this->h = height;
+        if (width * height > 0){
+            this->cells = new FrameBuffer::Cell[width * height];
+        }
+    }
+
+    this->clear();
+}
+
+void FrameBuffer::clear() {
+    const FrameBuffer::Cell b = FrameBuffer::blank();
+    for (int i = 0; i < this->w * this->h; i++) {
+        this->cells[i] = b;
+    }
+}
+
+void FrameBuffer::swap(FrameBuffer& other) {
+    FrameBuffer::Cell* c = this->cells;
+    this->cells = other.cells;
+    other.cells = c;
+
+    int t = this->w;
+    this->w = other.w;
+    other.w = t;
+
+    t = this->h;
+    this->h = other.h;
+    other.h = t;
+}
+
+void FrameBuffer::copyFrom(const FrameBuffer& other) {
+    if (this == &other){
+        return;
+    }
+
+    if (other.w != this->w || other.h != this->h){
+        this->resize(other.w, other.h);
+    }
+
+    for (int i = 0; i < this->w * this->h; i++) {
+        this->cells[i] = other.cells[i];
+    }
+}
+
+void FrameBuffer::blit(const FrameBuffer& other, int y, int x,
+int h, int w) {
+    if (this == &other){
+        return;
+    }
+
+    int y0 = y < 0 ? 0 : y;
+    int x0 = x < 0 ? 0 : x;
+    int y1 = y + h;
+    int x1 = x + w;
+    if (y1 > this->h) y1 = this->h;
+    if (y1 > other.h) y1 = other.h;
+    if (x1 > this->w) x1 = this->w;
+    if (x1 > other.w) x1 = other.w;
+
+    for (int row = y0; row < y1; row++) {
+        for (int col = x0; col < x1; col++) {
+            this->cells[row * this->w + col] = other.cells[row * other.w + col];
+        }
+    }
+}
+
+int FrameBuffer::width() const {
+    return this->w;
+}
+
+int FrameBuffer::height() const {
+    return this->h;
+}
+
+bool FrameBuffer::contains(int y, int x) const {
+    return y >= 0 && x >= 0 && y < this->h && x < this->w;
+}
+
+const FrameBuffer::Cell& FrameBuffer::at(int y, int x) const {
+    return this->cells[y * this->w + x];
+}
+
+void FrameBuffer::put(int y, int x, char ch, unsigned char color,
+unsigned char attr) {
+    if (!this->contains(y, x)){
+        return;
+    }
+
+    FrameBuffer::Cell& c = this->cells[y * this->w + x];
+    c.ch = ch;
+    c.color = color;
+    c.attr = attr;
+}
+
+int FrameBuffer::print(int y, int x, const char* s, unsigned char color,
+unsigned char attr) {
+    if (s == nullptr){
+        return 0;
+    }
+
+    int n = 0;
+    for (; s[n] != '\0'; n++) {
+        this->put(y, x + n, s[n], color, attr);
+    }
+    return n;
+}
+
+void FrameBuffer::box(int y, int x, int h, int w, unsigned char color,
+unsigned char attr) {
+    this->put(y,     x,     '+', color, attr);
+    this->put(y,     x+w-1, '+', color, attr);
+    this->put(y+h-1, x,     '+', color, attr);
+    this->put(y+h-1, x+w-1, '+', color, attr);
+
+    for (int i = 1; i < w-1; i++) {
+        this->put(y,     x+i, '-', color, attr);
+        this->put(y+h-1, x+i, '-', color, attr);
+    }
+
+    for (int i = 1; i < h-1; i++) {
+        this->put(y+i, x,     '|', color, attr);
+        this->put(y+i, x+w-1, '|', color, attr);
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @file framebuffer.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief in-memory grid of attributed characters
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * a FrameBuffer stores one screen worth of cells (character, color
+ * pair and attribute flags) without touching the terminal
+ *
+ * the renderer composes a frame in a buffer, compares it with the
+ * buffer of the previous frame and sends to the terminal only the
+ * cells that changed
+ *
+ */
+
+#ifndef FRAMEBUFFER_HPP
+#define FRAMEBUFFER_HPP
+
+#include <exception>
+
+/**
+ * @brief screen sized grid of cells
+ *
+ * every write is clipped to the buffer, so callers can draw
+ * partially visible shapes without bounds checks
+ */
+class FrameBuffer {
+public:
+    /**
+     * @brief attribute flags of a cell
+     */
+    enum Attr {
+        NORMAL = 0,
+        BOLD = 1,
+        DIM = 2,
+        REVERSE = 4
+    };
+
+    /**
+     * @brief a single character cell
+     */
+    struct Cell {
+        char ch; // printable ascii character
+        unsigned char color; // color pair, 0 = terminal default
+        unsigned char attr; // FrameBuffer::Attr flags
+
+        bool operator==(const Cell& other) const {
+            return this->ch == other.ch && this->color == other.color
+            && this->attr == other.attr;
+        }
+
+        bool operator!=(const Cell& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief thrown when a buffer is resized to a negative size
+     */
+    class InvalidSizeException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "framebuffer has an invalid size";
+            }
+    };
+
+private:
+    Cell* cells;
+    int w, h;
+
+public:
+    /**
+     * @brief creates an empty (0x0) buffer
+     */
+    FrameBuffer();
+
+    /**
+     * @brief creates a blank buffer of the given size
+     */
+    FrameBuffer(int width, int height);
+
+    ~FrameBuffer();
+
+    // buffers are swapped, never copied
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    /**
+     * @brief changes the size, the content becomes blank
+     *
+     * memory is reallocated only when the size changes
+     *
+     * @throws InvalidSizeException if width or height are negative
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief fills the buffer with blank cells
+     */
+    void clear();
+
+    /**
+     * @brief exchanges the content of two buffers (no copy)
+     */
+    void swap(FrameBuffer& other);
+
+    /**
+     * @brief makes this buffer an exact copy of other
+     */
+    void copyFrom(const FrameBuffer& other);
+
+    /**
+     * @brief copies the h x w rectangle at (y,x) of other into the
+     * same rectangle of this buffer, clipped to both buffers
+     */
+    void blit(const FrameBuffer& other, int y, int x, int h, int w);
+
+    /**
+     * @brief returns the width in cells
+     */
+    int width() const;
+
+    /**
+     * @brief returns the height in cells
+     */
+    int height() const;
+
+    /**
+     * @brief returns true if (y,x) is inside the buffer
+     */
+    bool contains(int y, int x) const;
+
+    /**
+     * @brief returns the cell at (y,x), no bounds check
+     */
+    const FrameBuffer::Cell& at(int y, int x) const;
+
+    /**
+     * @brief writes a cell, clipped
+     */
+    void put(int y, int x, char ch, unsigned char color = 0,
+    unsigned char attr = FrameBuffer::NORMAL);
+
+    /**
+     * @brief writes a string on one row, clipped
+     *
+     * @return number of characters in s
+     */
+    int print(int y, int x, const char* s, unsigned char color = 0,
+    unsigned char attr = FrameBuffer::NORMAL);
+
+    /**
+     * @brief draws an ascii box (+, -, |), clipped
+     */
+    void box(int y, int x, int h, int w, unsigned char color = 0,
+    unsigned char attr = FrameBuffer::NORMAL);
+
+    /**
+     * @brief returns a blank cell
+     */
+    static FrameBuffer::Cell blank();
+};
+
+#endif
@@ -10,16 +10,26 @@
  */
 
 #include "game.hpp"
+#include "input.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
 // SECTION GAME PARAMETERS
 
 static const int LEVEL_COUNT = 5;
 
+// bonus mode levels, in the working directory
+static const char* const BONUS_FILE = "bonus.csv";
+
 static const int START_SCORE = 0;
 static const int START_MAX_BOMBS = 1;
 
 static const int FPS = 30;
 static const int FRAME_MS = 1000 / FPS;
+// how long a dropped reload is shown under the board
+static const int RELOAD_ERR_TICKS = 5 * FPS;
 
 #ifdef DEBUG_MODE
     static const int START_LIVES = 99;
@@ -31,9 +41,17 @@ static const int FRAME_MS = 1000 / FPS;
 
 //!SECTION
 
-Game::Game(): state(Game::MENU), level(nullptr), currentLevel(0), 
-worldTime(WORLD_TIME_START) {
+Game::Game(const LevelPack* levelPack): state(Game::MENU), level(nullptr),
+pack(levelPack), prewarmIndex(-1),
+currentLevel(0), worldTime(WORLD_TIME_START),
+bonusIndex(-1), bonusBuildIndex(-1), bonusMissing(-1),
+bonusReloadIndex(-1), bonusReloadAgain(false), reloadErrTicks(0) {
     this->bonusErrMsg[0] = '\0';
+    this->reloadErrMsg[0] = '\0';
+    this->bonusPath[0] = '\0';
+    for (int i = 0; i < BONUS_SLOTS; i++) {
+        this->bonusLevels[i] = nullptr;
+    }
     for (int i = 0; i < MAX_LEVEL_SIZE; i++) {
         this->levels[i] = nullptr;
     }
@@ -45,6 +63,9 @@ worldTime(WORLD_TIME_START) {
     this->player.setLives(START_LIVES);
     this->player.setScore(START_SCORE);
     this->player.setMaxBombs(START_MAX_BOMBS);
+
+    // ready by the time START GAME is chosen
+    this->prewarmLevel(0);
 }
 
 int Game::findNextIncomplete(int from) const {
@@ -96,8 +117,9 @@ void Game::handleMenu() {
 
         this->worldTime = WORLD_TIME_START;
 
-        loadLevel(currentLevel);
+        // before loading, a level that can't be built sets an error
         this->state = Game::State::PLAYING;
+        loadLevel(currentLevel);
         return;
     }
 
@@ -210,8 +232,21 @@ void Game::handleInput(int ch) {
 }
 
 void Game::update() {
+    // a saved bonus file replaces the level between two ticks
+    if (this->bonusMode && this->bonusWatch.isOpen()) {
+        if (this->bonusWatch.changed()){
+            this->reloadBonus();
+        }
+        this->collectReload(false);
+        if (this->reloadErrTicks > 0){
+            this->reloadErrTicks--;
+        }
+    }
+
+    Profiler::beginTick();
     this->level->update();
     this->player.updateMovementTimer();
+    Profiler::endTick();
     this->worldTime--;
 
     Level::TransitionRequest tr = this->level->getTransitionRequest();
@@ -222,7 +257,11 @@ void Game::update() {
         return;
     }
 
-    if (levelCompleted[currentLevel] == false) {
+    if (this->bonusMode) {
+        // the next level is parsed and built while this one is played
+        this->collectBonus(false);
+        this->prewarmBonus();
+    } else if (levelCompleted[currentLevel] == false) {
         if (level->getEnemies().len() == 0) {
             levelCompleted[currentLevel] = true;
         }
@@ -232,15 +271,13 @@ void Game::update() {
         if (this->bonusMode) {
             this->level->clearTransitionRequest();
 
-           
-            if (this->bonusLevels != nullptr) {
-                delete this->bonusLevels;
-                this->bonusLevels = nullptr;
+            // past the last level back to the menu
+            if (this->enterBonusLevel(this->bonusIndex + 1,
+            Level::TransitionRequest::NEXT) == BonusPack::Result::END) {
+                this->closeBonus();
+                this->resetGame();
+                this->state = Game::MENU;
             }
-
-            this->bonusMode = false;
-            this->resetGame();
-            this->state = Game::MENU; 
             return;
         }
 
@@ -264,13 +301,13 @@ void Game::update() {
         if (this->bonusMode) {
             this->level->clearTransitionRequest();
 
-           
-            if (this->bonusLevels != nullptr) {
-                delete this->bonusLevels;
-                this->bonusLevels = nullptr;
+            if (this->bonusIndex > 0) {
+                this->enterBonusLevel(this->bonusIndex - 1,
+                Level::TransitionRequest::PREV);
+                return;
             }
 
-            this->bonusMode = false;
+            this->closeBonus();
             this->resetGame();
             this->state = Game::State::MENU; 
             return;
@@ -298,31 +335,89 @@ void Game::render() {
         this->player.getScore(),
         this->player.getLives(),
         this->currentLevel,
-        this->level->getPowerUps()
+        this->level->getPowerUps(),
+        this->reloadErrTicks > 0 ? this->reloadErrMsg : nullptr
     );
 }
 
-void Game::initLevels() {
-    for (int i = 0; i < LEVEL_COUNT; i++){
-        levels[i] = nullptr;
+/**
+ * @brief returns the map of a classic level
+ *
+ * the maps are read-only tables built at compile time
+ */
+static const Map& builtinMap(int index) {
+    switch (index) {
+        case 1:
+            return MapBuilder::ram();
+        case 2:
+            return MapBuilder::storage();
+        case 3:
+            return MapBuilder::cpu();
+        case 4:
+            return MapBuilder::gpu();
+        default:
+            return MapBuilder::motherboard();
     }
+}
 
-    // static Map m0 = MapBuilder::outsand();
-    // static Map m1 = MapBuilder::crossroads();
+/**
+ * @brief builds a classic level from the pack, or from
+ * the builtin maps if there is no pack
+ *
+ * @return nullptr if the level can't be built (it may run on the
+ * prewarm thread, an exception would end in std::terminate)
+ */
+static Level* buildLevel(Player* p, const LevelPack* pack, int index) {
+    try {
+        if (pack != nullptr){
+            return new Level(p, MAP_WIDTH, MAP_HEIGHT, pack->at(index));
+        }
+        return new Level(p, MAP_WIDTH, MAP_HEIGHT, builtinMap(index));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
 
-    static Map motherboard = MapBuilder::motherboard();
-    static Map ram = MapBuilder::ram();
-    static Map storage = MapBuilder::storage();
-    static Map cpu = MapBuilder::cpu();
-    static Map gpu = MapBuilder::gpu();
+Level* Game::acquireLevel(int index) {
+    if (this->levels[index] != nullptr){
+        return this->levels[index];
+    }
 
-    this->levels[0] = new Level(&player, MAP_WIDTH, MAP_HEIGHT, motherboard);
-    this->levels[1] =  new Level(&player, MAP_WIDTH, MAP_HEIGHT, ram);
-    this->levels[2] = new Level(&player, MAP_WIDTH, MAP_HEIGHT, storage);
-    this->levels[3] = new Level(&player, MAP_WIDTH, MAP_HEIGHT, cpu);
-    this->levels[4] = new Level(&player, MAP_WIDTH, MAP_HEIGHT, gpu);
+    if (this->prewarmIndex == index) {
+        this->prewarmIndex = -1;
+        this->levels[index] = this->prewarmed.get();
+        return this->levels[index];
+    }
 
-    this->player.setSpawn(levels[0]->getSpawnX(), levels[0]->getSpawnY());
+    this->levels[index] = buildLevel(&this->player, this->pack, index);
+    return this->levels[index];
+}
+
+void Game::prewarmLevel(int index) {
+    if (index < 0 || index >= LEVEL_COUNT){
+        return;
+    }
+    if (this->levels[index] != nullptr || this->prewarmIndex != -1){
+        return;
+    }
+
+    // the level only keeps the player pointer, onEnter()
+    // is what links the player to the board
+    Player* p = &this->player;
+    const LevelPack* source = this->pack;
+    this->prewarmIndex = index;
+    this->prewarmed = std::async(std::launch::async,
+    [p, source, index]() {
+        return buildLevel(p, source, index);
+    });
+}
+
+void Game::cancelPrewarm() {
+    if (this->prewarmIndex == -1){
+        return;
+    }
+    this->prewarmIndex = -1;
+    delete this->prewarmed.get();
 }
 
 void Game::nextLevel() {
@@ -331,9 +426,6 @@ void Game::nextLevel() {
     if (next >= LEVEL_COUNT){
         return;
     }
-    if (this->levels[next] == nullptr){
-        return;
-    }
 
     setCurrentLevel(next, Level::TransitionRequest::NEXT);
 }
@@ -344,9 +436,6 @@ void Game::prevLevel() {
     if (prev < 0){
         return;
     }
-    if (levels[prev] == nullptr){
-        return;
-    }
 
     setCurrentLevel(prev, Level::TransitionRequest::PREV);
 }
@@ -355,7 +444,13 @@ void Game::setCurrentLevel(int index, Level::TransitionRequest from) {
     if (index < 0 || index >= LEVEL_COUNT){
         return;
     }
-    if (this->levels[index] == nullptr){
+
+    Level* target = this->acquireLevel(index);
+    if (target == nullptr) {
+        // the current level (if any) stays as it is
+        snprintf(this->bonusErrMsg, sizeof(this->bonusErrMsg),
+        "Cannot create level %d.", index + 1);
+        this->state = Game::State::BONUS_ERROR;
         return;
     }
 
@@ -364,7 +459,7 @@ void Game::setCurrentLevel(int index, Level::TransitionRequest from) {
     }
 
     this->currentLevel = index;
-    this->level = this->levels[index];
+    this->level = target;
 
     if(this->currentLevel == 0){
         this->player.setMaxBombs(1);
@@ -376,6 +471,9 @@ void Game::setCurrentLevel(int index, Level::TransitionRequest from) {
     }
 
     this->level->onEnter(from);
+
+    // the gate to the next level is the likely way out
+    this->prewarmLevel(index + 1);
 }
 
 void Game::resetGame() {
@@ -391,62 +489,330 @@ void Game::resetGame() {
 
     this->currentLevel = 0;
 
+    // the levels are kept for the next run, a reset
+    // reuses their boards, lists and pools
     for(int i = 0; i < LEVEL_COUNT; i++){
-        if(this->levels[i] != nullptr){
-            delete this->levels[i];
-            this->levels[i] = nullptr;
+        if(this->levels[i] == nullptr){
+            continue;
+        }
+        if (this->pack != nullptr) {
+            this->levels[i]->reset(this->pack->at(i));
+        } else {
+            this->levels[i]->reset(builtinMap(i));
         }
     }
     this->level = nullptr;
 
+    // no-op unless level 0 was never built
+    this->prewarmLevel(0);
+
 
     this->state = MENU;
 }
 
 void Game::loadBonusLevelFromFile(const char* path) {
-    char err[128];
-    err[0] = '\0';
-
-    //bonus map info
-    static Map bonusMap;
-
-    bool ok = Parser::loadBonusFile(path, bonusMap, err, 128);
-    if (!ok) {
-        // copy error into buffer
-        int i = 0;
-        for (; err[i] != '\0' && i < 127; i++){
-            this->bonusErrMsg[i] = err[i];
-        }
-        this->bonusErrMsg[i] = '\0';
+    this->bonusErrMsg[0] = '\0';
+
+    const int n = snprintf(this->bonusPath, sizeof(this->bonusPath), "%s",
+    path);
+    if (n < 0 || n >= (int)sizeof(this->bonusPath)) {
+        this->bonusPath[0] = '\0';
+        snprintf(this->bonusErrMsg, sizeof(this->bonusErrMsg),
+        "Bonus file path too long.");
+        this->state = Game::State::BONUS_ERROR;
+        return;
+    }
 
+    Parser::Diagnostics diag;
+    if (!this->bonusPack.open(path, &diag)) {
+        Parser::formatError(diag.errors[0], this->bonusErrMsg,
+        (int)sizeof(this->bonusErrMsg));
         this->state = Game::State::BONUS_ERROR;
         return;
     }
 
-    // allocate bonus level
+    // a file has at least a level, END can't happen here
+    if (this->enterBonusLevel(0, Level::TransitionRequest::NONE) !=
+    BonusPack::Result::LEVEL) {
+        this->state = Game::State::BONUS_ERROR;
+    }
+}
+
+Game::BonusBuild Game::buildBonusLevel(Player* p, BonusPack* file,
+int index) {
+    Game::BonusBuild b;
+    b.level = nullptr;
+    b.error[0] = '\0';
+
+    // a few KB, on the stack of the building thread
+    Map map;
+    Parser::Diagnostics diag;
+    b.result = file->read(index, map, &diag);
+
+    if (b.result == BonusPack::Result::FAILED) {
+        // "level N, " then the parser message
+        int used = 0;
+        if (file->isMultiLevel()) {
+            used = snprintf(b.error, sizeof(b.error), "level %d, ",
+            index + 1);
+        }
+        Parser::formatError(diag.errors[0], b.error + used,
+        (int)sizeof(b.error) - used);
+        return b;
+    }
+    if (b.result != BonusPack::Result::LEVEL){
+        return b;
+    }
+
     try {
-        this->bonusLevels = new Level(
-            &player, 
-            MAP_WIDTH, 
-            MAP_HEIGHT, 
-            bonusMap
-        );
-    } catch (const std::exception& ex) {
-        const char* msg = "Cannot create bonus level.";
-        int i = 0;
-        for (; msg[i] != '\0' && i < 127; i++){
-            this->bonusErrMsg[i] = msg[i];
+        b.level = new Level(p, MAP_WIDTH, MAP_HEIGHT, map);
+    } catch (const std::exception&) {
+        b.result = BonusPack::Result::FAILED;
+        snprintf(b.error, sizeof(b.error), "Cannot create bonus level %d.",
+        index + 1);
+    }
+    return b;
+}
+
+BonusPack::Result Game::enterBonusLevel(int index,
+Level::TransitionRequest from) {
+    const bool forward = index > this->bonusIndex;
+    const int slot = forward ? BONUS_NEXT : BONUS_PREV;
+
+    // the background build is often this very level
+    this->collectBonus(true);
+
+    Level* target = this->bonusLevels[slot];
+    if (target == nullptr) {
+        Game::BonusBuild b = Game::buildBonusLevel(&this->player,
+        &this->bonusPack, index);
+        if (b.result != BonusPack::Result::LEVEL) {
+            snprintf(this->bonusErrMsg, sizeof(this->bonusErrMsg), "%s",
+            b.error);
+            if (b.result == BonusPack::Result::FAILED){
+                this->state = Game::State::BONUS_ERROR;
+            }
+            return b.result;
         }
-        this->bonusErrMsg[i] = '\0';
+        target = b.level;
+    }
 
-        this->state = Game::State::BONUS_ERROR;
+    if (this->level != nullptr){
+        this->level->onExit(); // clear placed bombs
+    }
+
+    // slide the window, the level left behind stays built
+    if (forward) {
+        delete this->bonusLevels[BONUS_PREV];
+        this->bonusLevels[BONUS_PREV] = this->bonusLevels[BONUS_CURRENT];
+        this->bonusLevels[BONUS_NEXT] = nullptr;
+    } else {
+        delete this->bonusLevels[BONUS_NEXT];
+        this->bonusLevels[BONUS_NEXT] = this->bonusLevels[BONUS_CURRENT];
+        this->bonusLevels[BONUS_PREV] = nullptr;
+    }
+    this->bonusLevels[BONUS_CURRENT] = target;
+
+    this->bonusIndex = index;
+    this->currentLevel = index;
+    this->level = target;
+    this->level->onEnter(from);
+
+    this->prewarmBonus();
+    return BonusPack::Result::LEVEL;
+}
+
+void Game::prewarmBonus() {
+    if (this->bonusBuildIndex != -1 || this->bonusIndex < 0){
+        return;
+    }
+
+    int index = this->bonusIndex + 1;
+    if (this->bonusLevels[BONUS_NEXT] != nullptr ||
+    index == this->bonusMissing) {
+        index = this->bonusIndex - 1;
+        if (index < 0 || this->bonusLevels[BONUS_PREV] != nullptr ||
+        index == this->bonusMissing){
+            return;
+        }
+    }
+
+    // only this thread reads the file until the build is collected
+    Player* p = &this->player;
+    BonusPack* file = &this->bonusPack;
+    this->bonusBuildIndex = index;
+    this->bonusBuilt = std::async(std::launch::async,
+    [p, file, index]() {
+        return Game::buildBonusLevel(p, file, index);
+    });
+}
+
+void Game::collectBonus(bool wait) {
+    if (this->bonusBuildIndex == -1){
+        return;
+    }
+    if (!wait && this->bonusBuilt.wait_for(std::chrono::seconds(0)) !=
+    std::future_status::ready){
         return;
     }
+
+    const int index = this->bonusBuildIndex;
+    this->bonusBuildIndex = -1;
+    Game::BonusBuild b = this->bonusBuilt.get();
+
+    if (b.result != BonusPack::Result::LEVEL) {
+        // built again (and reported) if the player gets there
+        this->bonusMissing = index;
+        return;
+    }
+
+    if (index == this->bonusIndex + 1 &&
+    this->bonusLevels[BONUS_NEXT] == nullptr) {
+        this->bonusLevels[BONUS_NEXT] = b.level;
+    } else if (index == this->bonusIndex - 1 &&
+    this->bonusLevels[BONUS_PREV] == nullptr) {
+        this->bonusLevels[BONUS_PREV] = b.level;
+    } else {
+        delete b.level;
+    }
+}
+
+void Game::closeBonus() {
+    this->bonusWatch.close();
+    this->bonusReloadAgain = false;
+    this->collectReload(true);
+    this->reloadErrTicks = 0;
+    this->collectBonus(true);
+    for (int i = 0; i < BONUS_SLOTS; i++) {
+        delete this->bonusLevels[i];
+        this->bonusLevels[i] = nullptr;
+    }
+    this->bonusPack.close();
+    this->bonusIndex = -1;
+    this->bonusMissing = -1;
+    this->bonusMode = false;
+}
+
+Game::BonusReload Game::readBonusFile(const char* path, Player* p,
+int index) {
+    Game::BonusReload r;
+    r.file = new BonusPack();
+    r.build.level = nullptr;
+    r.build.error[0] = '\0';
+
+    Parser::Diagnostics diag;
+    if (!r.file->open(path, &diag)) {
+        delete r.file;
+        r.file = nullptr;
+        r.build.result = BonusPack::Result::FAILED;
+        Parser::formatError(diag.errors[0], r.build.error,
+        (int)sizeof(r.build.error));
+        return r;
+    }
+
+    r.build = Game::buildBonusLevel(p, r.file, index);
+    if (r.build.result == BonusPack::Result::END) {
+        snprintf(r.build.error, sizeof(r.build.error),
+        "level %d is no longer in the file", index + 1);
+    }
+    return r;
+}
+
+void Game::reloadBonus() {
+    if (this->bonusReloadIndex != -1) {
+        // read again once this one is done
+        this->bonusReloadAgain = true;
+        return;
+    }
+
+    // bonusPath only changes after closeBonus() waited for this read
+    Player* p = &this->player;
+    const char* path = this->bonusPath;
+    const int index = this->bonusIndex;
+    this->bonusReloadIndex = index;
+    this->bonusReloadAgain = false;
+    this->bonusReloaded = std::async(std::launch::async,
+    [p, path, index]() {
+        return Game::readBonusFile(path, p, index);
+    });
+}
+
+void Game::collectReload(bool wait) {
+    if (this->bonusReloadIndex == -1){
+        return;
+    }
+    if (!wait && this->bonusReloaded.wait_for(std::chrono::seconds(0)) !=
+    std::future_status::ready){
+        return;
+    }
+
+    const int index = this->bonusReloadIndex;
+    this->bonusReloadIndex = -1;
+    Game::BonusReload r = this->bonusReloaded.get();
+
+    // errors keep the level being played, after a gate taken
+    // meanwhile the new current level is read
+    const bool stale = index != this->bonusIndex;
+    if (!wait && !stale && r.build.result != BonusPack::Result::LEVEL) {
+        // shown under the board for a few seconds, the file name
+        // without its directories
+        const char* name = strrchr(this->bonusPath, '/');
+        name = name != nullptr ? name + 1 : this->bonusPath;
+        snprintf(this->reloadErrMsg, sizeof(this->reloadErrMsg),
+        "%.40s not reloaded: %s", name, r.build.error);
+        this->reloadErrTicks = RELOAD_ERR_TICKS;
+    }
+    if (wait || stale || r.build.result != BonusPack::Result::LEVEL) {
+        delete r.build.level;
+        delete r.file;
+        if (stale){
+            this->bonusReloadAgain = true;
+        }
+    } else {
+        // the background build still reads the old file
+        this->collectBonus(true);
+        this->bonusPack.swap(*r.file);
+        delete r.file;
+
+        // the neighbours come from the old file
+        delete this->bonusLevels[BONUS_PREV];
+        delete this->bonusLevels[BONUS_NEXT];
+        this->bonusLevels[BONUS_PREV] = nullptr;
+        this->bonusLevels[BONUS_NEXT] = nullptr;
+        this->bonusMissing = -1;
+        this->reloadErrTicks = 0;
+
+        const unsigned short px = this->player.getX();
+        const unsigned short py = this->player.getY();
+
+        Level* old = this->bonusLevels[BONUS_CURRENT];
+        old->onExit();
+        this->bonusLevels[BONUS_CURRENT] = r.build.level;
+        this->level = r.build.level;
+        this->level->onEnter(Level::TransitionRequest::NONE);
+        delete old;
+
+        if (this->level->getBoard().isWalkable(px, py)) {
+            this->player.setX(px);
+            this->player.setY(py);
+        }
+
+        this->prewarmBonus();
+    }
+
+    if (this->bonusReloadAgain && !wait){
+        this->reloadBonus();
+    }
+}
+
+void Game::setHotReload(bool on) {
+    this->hotReload = on;
 }
 
 void Game::run() {
 
-    this->leaderboard.load("scores.csv");
+    // kept open: scores are appended, never rewritten
+    this->leaderboard.open("scores.csv");
     while (this->state != Game::State::EXIT) {
 
         if (this->state == Game::State::MENU) {
@@ -455,44 +821,49 @@ void Game::run() {
         }
 
         if (this->state == Game::State::PLAYING) {
-            int ch = getch();
-            this->handleInput(ch);
+            // all the keys that arrived since the last tick,
+            // held keys don't queue up behind the game
+            int keys[Input::MAX_TICK_KEYS];
+            Input::drain();
+            int n = Input::collapse(keys, Input::MAX_TICK_KEYS);
+            for (int i = 0; i < n && this->state == Game::State::PLAYING; i++) {
+                this->handleInput(keys[i]);
+            }
             this->update();
             this->render();
         } else if (state == Game::State::GAMEOVER) {
 
-            erase();
-            mvprintw(LINES/2, (COLS - 9)/2, "GAME OVER");
-            mvprintw(LINES/2 + 2, (COLS - 24)/2, "Press ENTER for menu");
-            mvprintw(LINES/2 + 3, (COLS - 12)/2, "Press Q to quit");
-            refresh();
+            // redrawn only when a key (or a resize) arrives
+            while (this->state == Game::State::GAMEOVER) {
+                Render::drawEndScreen(false);
 
-            int ch = getch();
+                int ch = Input::waitKey(Input::WAIT_FOREVER);
 
-            if (ch == 'q' || ch == 'Q') {
-                this->state = Game::State::EXIT;
-            }
-            if (ch == 10 || ch == KEY_ENTER) {
-                this->lastVictory = false;
-                this->state = Game::State::MENU;
+                if (ch == 'q' || ch == 'Q') {
+                    this->state = Game::State::EXIT;
+                }
+                if (ch == 10 || ch == KEY_ENTER) {
+                    this->lastVictory = false;
+                    this->state = Game::State::MENU;
+                }
             }
+            continue;
         } else if (state == WIN) {
-            erase();
-            mvprintw(LINES/2, (COLS - 8)/2, "YOU WIN!");
-            mvprintw(LINES/2 + 2, (COLS - 28)/2, "Press ENTER for menu");
-            mvprintw(LINES/2 + 3, (COLS - 16)/2, "Press Q to quit");
-            refresh();
+            while (this->state == Game::State::WIN) {
+                Render::drawEndScreen(true);
 
-            int ch = getch();
+                int ch = Input::waitKey(Input::WAIT_FOREVER);
 
-            if (ch == 'q' || ch == 'Q'){
-                state = EXIT;
-            }
+                if (ch == 'q' || ch == 'Q'){
+                    state = EXIT;
+                }
 
-            if (ch == 10 || ch == KEY_ENTER) {
-                this->state = Game::State::MENU;
-                this->lastVictory = true;
+                if (ch == 10 || ch == KEY_ENTER) {
+                    this->state = Game::State::MENU;
+                    this->lastVictory = true;
+                }
             }
+            continue;
         } else if (this->state == Game::State::NAME_ENTRY) {
 
             char name[4];
@@ -506,10 +877,12 @@ void Game::run() {
             }
 
             if (ok) {
-                this->leaderboard.add(name, finalScore);
-                this->leaderboard.save("scores.csv"); 
+                this->leaderboard.submit(name, finalScore);
             }
 
+            if (this->bonusMode){
+                this->closeBonus();
+            }
             resetGame();
             if(this->lastVictory){
                 this->state = Game::State::WIN;
@@ -519,25 +892,22 @@ void Game::run() {
             this->bonusMode = false;
             continue;
         } else if (this->state == Game::State::LEADERBOARD_INPUT){
-                nodelay(stdscr, FALSE);
                 flushinp(); 
 
-                this->leaderboard.load("scores.csv");
+                // with the scores of other games
+                this->leaderboard.refresh();
 
                 int maxEntries = this->leaderboard.size();
                 if (maxEntries <= 0) {
-                    nodelay(stdscr, FALSE);
-
                     // input drain
                     nodelay(stdscr, TRUE);
                     int c;
                     while ((c = getch()) != ERR) { }
-                    nodelay(stdscr, FALSE);
 
                     Render::drawLeaderboardEmpty();
 
                     // wait for ENTER/Q
-                    int ch2 = getch();
+                    int ch2 = Input::waitKey(Input::WAIT_FOREVER);
                     (void)ch2;
 
                     // clear leaderboard and go back
@@ -553,7 +923,7 @@ void Game::run() {
 
                 while (true) {
                     Render::drawLeaderboardAskCount(maxEntries, current);
-                    int ch2 = getch();
+                    int ch2 = Input::waitKey(Input::WAIT_FOREVER);
 
                     if (ch2 == 'q' || ch2 == 'Q' || ch2 == 27 /* ESC */) {
                         flushinp();
@@ -585,6 +955,17 @@ void Game::run() {
                             current = 1;
                         }
                     }
+                    else if (ch2 == KEY_PPAGE) {
+                        // tenfold, for tables of any size
+                        current = current > maxEntries / 10 ?
+                        maxEntries : current * 10;
+                    }
+                    else if (ch2 == KEY_NPAGE) {
+                        current /= 10;
+                        if (current < 1){
+                            current = 1;
+                        }
+                    }
                     else if (ch2 == 10 || ch2 == KEY_ENTER) {
                         this->leaderboardCountToShow = current;
                         flushinp();
@@ -595,14 +976,8 @@ void Game::run() {
 
                 continue;
         }  else if (this->state == Game::State::LEADERBOARD_VIEW) {
-                nodelay(stdscr, FALSE);
                 flushinp();
 
-                Render::drawLeaderboard(this->leaderboard, 
-                this->leaderboardCountToShow, this->leaderboardPage);
-
-                int ch = getch();
-
                 int total = this->leaderboard.size();
                 int maxShow = this->leaderboardCountToShow;
                 if (maxShow < 1){
@@ -619,81 +994,87 @@ void Game::run() {
                     pages = 1;
                 }
 
-                if (ch == KEY_LEFT) {
-                    if (this->leaderboardPage > 0){
-                        this->leaderboardPage--;
-                    }
-                } else if (ch == KEY_RIGHT) {
-                    if (this->leaderboardPage < pages - 1){
-                        this->leaderboardPage++;
+                while (this->state == Game::State::LEADERBOARD_VIEW) {
+                    Render::drawLeaderboard(this->leaderboard, 
+                    this->leaderboardCountToShow, this->leaderboardPage);
+
+                    int ch = Input::waitKey(Input::WAIT_FOREVER);
+
+                    if (ch == KEY_LEFT) {
+                        if (this->leaderboardPage > 0){
+                            this->leaderboardPage--;
+                        }
+                    } else if (ch == KEY_RIGHT) {
+                        if (this->leaderboardPage < pages - 1){
+                            this->leaderboardPage++;
+                        }
+                    } else if (ch == KEY_HOME) {
+                        this->leaderboardPage = 0;
+                    } else if (ch == KEY_END) {
+                        this->leaderboardPage = pages - 1;
+                    } else if (ch == 'q' || ch == 'Q' ||
+                    ch == 27 || ch == 10 || ch == KEY_ENTER) {
+                        state = Game::State::MENU;
+                        flushinp();
                     }
-                } else if (ch == 'q' || ch == 'Q' ||
-                ch == 27 || ch == 10 || ch == KEY_ENTER) {
-                    state = Game::State::MENU;
-                    flushinp();
                 }
 
             continue;
         } else if (this->state == Game::State::CREDITS) {
-            nodelay(stdscr, FALSE);
-
-            Render::drawCredits();
+            while (this->state == Game::State::CREDITS) {
+                Render::drawCredits();
 
-            int ch2 = getch();
-            if (ch2 == 'q' || ch2 == 'Q' ||
-                ch2 == 10 || ch2 == KEY_ENTER ||
-                ch2 == 27 /* ESC */) {
+                int ch2 = Input::waitKey(Input::WAIT_FOREVER);
+                if (ch2 == 'q' || ch2 == 'Q' ||
+                    ch2 == 10 || ch2 == KEY_ENTER ||
+                    ch2 == 27 /* ESC */) {
 
-                this->state = Game::State::MENU;
-                flushinp();
+                    this->state = Game::State::MENU;
+                    flushinp();
+                }
             }
+            continue;
         } else if (this->state == Game::State::BONUS) {
+            this->closeBonus();
             this->bonusMode = true;
             this->worldTime = WORLD_TIME_START;
 
-            if (this->bonusLevels != nullptr) {
-                delete this->bonusLevels;
-                this->bonusLevels = nullptr;
-            }
+            this->loadBonusLevelFromFile(BONUS_FILE);
 
-            this->loadBonusLevelFromFile("bonus.csv");
+            // no watch (no inotify) only means no reload
+            if (this->hotReload && this->state != Game::State::BONUS_ERROR){
+                this->bonusWatch.open(this->bonusPath);
+            }
 
             if (this->state == Game::State::BONUS_ERROR){
                 continue;
             }
 
-            this->currentLevel = 0;
-            this->level = bonusLevels;
-            this->level->onEnter(Level::TransitionRequest::NONE);
-
             this->state = Game::State::PLAYING;
            continue;
 
         } else if (this->state == Game::State::BONUS_ERROR) {
-            nodelay(stdscr, FALSE);
-
             const char* msg = "UNKNOWN BONUS ERROR";
             if (this->bonusErrMsg[0] != '\0') {
                 msg = this->bonusErrMsg;
             }
 
-            Render::drawBonusError(msg);
+            while (this->state == Game::State::BONUS_ERROR) {
+                Render::drawBonusError(msg, this->bonusMode ?
+                "BONUS MODE ERROR" : "LEVEL ERROR");
 
-            int ch = getch();
+                int ch = Input::waitKey(Input::WAIT_FOREVER);
 
-            if (ch == 10 || ch == KEY_ENTER ||
-                ch == 'q' || ch == 'Q' ||
-                ch == 27 /* ESC */) {
+                if (ch == 10 || ch == KEY_ENTER ||
+                    ch == 'q' || ch == 'Q' ||
+                    ch == 27 /* ESC */) {
 
-                flushinp();
+                    flushinp();
 
-                if (this->bonusLevels != nullptr) {
-                    delete this->bonusLevels;
-                    this->bonusLevels = nullptr;
+                    // a later level can fail after some play
+                    this->closeBonus();
+                    this->resetGame();
                 }
-
-                level = nullptr;
-                state = Game::State::MENU;
             }
             continue;
         }
@@ -703,10 +1084,6 @@ void Game::run() {
 }
 
 void Game::loadLevel(int index) {
-    if (this->levels[0] == nullptr) {
-        this->initLevels();
-    }
-
     this->setCurrentLevel(index, Level::TransitionRequest::NONE);   
 }
 
@@ -714,13 +1091,14 @@ void Game::handleLeaderboardView() {
     Render::drawLeaderboard(this->leaderboard, 
     this->leaderboardCountToShow,this->leaderboardPage);
 
-    int ch = getch();
+    int ch = Input::waitKey(Input::WAIT_FOREVER);
     if (ch == 'q' || ch == 'Q' || ch == 10 || ch == KEY_ENTER) {
         this->state = Game::State::MENU;
     }
 }
 
 Game::~Game(){
+    this->cancelPrewarm();
     for(int i = 0; i < LEVEL_COUNT; i++){
         if(this->levels[i] != nullptr){
             delete this->levels[i];
@@ -728,7 +1106,5 @@ Game::~Game(){
         }
     }
 
-    if(this->bonusLevels != nullptr){
-        delete this->bonusLevels;
-    }
+    this->closeBonus();
 }
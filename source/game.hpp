@@ -28,6 +28,11 @@
 #include "leaderboard.hpp"
 #include "name_entry.hpp"
 #include "parser.hpp"
+#include "levelpack.hpp"
+#include "bonus_pack.hpp"
+#include "file_watcher.hpp"
+
+#include <future>
 
 /**
  * @brief standard level number
@@ -64,6 +69,38 @@ public:
     };
 
 private:
+    /**
+     * @brief size of the bonus file path, terminator included
+     */
+    static const int PATH_SIZE = 512;
+
+    /**
+     * @brief a bonus level built from the bonus file
+     */
+    struct BonusBuild {
+        Level* level; // nullptr unless result is LEVEL
+        BonusPack::Result result;
+        char error[128];
+    };
+
+    /**
+     * @brief the bonus file read again after a change
+     */
+    struct BonusReload {
+        BonusPack* file; // the new file, nullptr if it can't be read
+        BonusBuild build; // the level being played, from file
+    };
+
+    /**
+     * @brief slots of bonusLevels
+     */
+    enum BonusSlot {
+        BONUS_PREV,
+        BONUS_CURRENT,
+        BONUS_NEXT,
+        BONUS_SLOTS
+    };
+
     //current game state
     State state;
 
@@ -74,6 +111,14 @@ private:
     // current level pointer
     Level* level;
 
+    // classic levels source, nullptr for the builtin maps
+    const LevelPack* pack;
+
+    // level being built in the background, prewarmIndex
+    // is -1 when nothing is being built
+    std::future<Level*> prewarmed;
+    int prewarmIndex;
+
     // current level index
     int currentLevel;
     // remaining time for the current run 
@@ -92,10 +137,41 @@ private:
     //true if bonus mode is activve
     bool bonusMode = false;
 
-    // bonus level pointer, loaded from file
-    Level* bonusLevels = nullptr;
+    // bonus file, read one level at a time
+    BonusPack bonusPack;
+
+    // built bonus levels around the one being played, the
+    // others are freed (nullptr if not built)
+    Level* bonusLevels[BONUS_SLOTS];
+    // bonus level being played, -1 before the first
+    int bonusIndex;
+
+    // bonus level being built in the background, bonusBuildIndex
+    // is -1 when nothing is being built
+    std::future<BonusBuild> bonusBuilt;
+    int bonusBuildIndex;
+    // a bonus level that failed or doesn't exist, it is not
+    // built again in the background
+    int bonusMissing;
+
+    // true if the bonus file is reloaded when it changes (--watch)
+    bool hotReload = false;
+    FileWatcher bonusWatch;
+    // the file loadBonusLevelFromFile() opened, watched and read again
+    char bonusPath[Game::PATH_SIZE];
+
+    // bonus file being read again in the background, for the
+    // level bonusReloadIndex (-1 when nothing is being read)
+    std::future<BonusReload> bonusReloaded;
+    int bonusReloadIndex;
+    // the file changed again while it was being read
+    bool bonusReloadAgain;
+    // why the last reload was dropped, shown under the board
+    // for reloadErrTicks more ticks
+    char reloadErrMsg[192];
+    int reloadErrTicks;
 
-    // reading file and bonus level error msg
+    // reading file, bonus level or level build error msg
     char bonusErrMsg[128];
 
     //completion status for each level
@@ -127,9 +203,21 @@ private:
     void loadLevel(int index);
 
     /**
-     * @brief initializes all classic levels
-     */    
-    void initLevels();
+     * @brief returns the classic level at index, building it
+     * (or waiting for the background build) on first use
+     */
+    Level* acquireLevel(int index);
+
+    /**
+     * @brief starts building the level at index on a background
+     * thread, does nothing if it is built or already being built
+     */
+    void prewarmLevel(int index);
+
+    /**
+     * @brief waits for the background build and deletes its level
+     */
+    void cancelPrewarm();
 
     /**
      * @brief moves to the next level
@@ -161,10 +249,75 @@ private:
     void handleLeaderboardView();
 
     /**
-     * @brief loads a bonus level from file (bonus.csv)
+     * @brief opens a bonus file (bonus.csv) and enters its first
+     * level, the state is BONUS_ERROR on failure
+     *
+     * path is kept in bonusPath, hot reload reads it again
      */
     void loadBonusLevelFromFile(const char* path);
 
+    /**
+     * @brief reads and builds a bonus level, runs on any thread
+     */
+    static BonusBuild buildBonusLevel(Player* p, BonusPack* file,
+    int index);
+
+    /**
+     * @brief moves to the bonus level next to the current one
+     * (index is bonusIndex + 1 or bonusIndex - 1)
+     *
+     * the level is taken from bonusLevels or from the background
+     * build, it is built here only if neither has it
+     *
+     * @return LEVEL, END past the last level, FAILED with the
+     * message in bonusErrMsg
+     */
+    BonusPack::Result enterBonusLevel(int index,
+    Level::TransitionRequest from);
+
+    /**
+     * @brief starts building a missing neighbour of the current
+     * bonus level (the next one first) in the background
+     */
+    void prewarmBonus();
+
+    /**
+     * @brief stores the background bonus build in bonusLevels
+     *
+     * @param wait if false, returns at once if it is not finished
+     */
+    void collectBonus(bool wait);
+
+    /**
+     * @brief frees the bonus levels, closes the file and leaves
+     * bonus mode
+     */
+    void closeBonus();
+
+    /**
+     * @brief opens path again and builds its level at index, runs
+     * on any thread
+     */
+    static BonusReload readBonusFile(const char* path, Player* p,
+    int index);
+
+    /**
+     * @brief starts reading the changed bonus file (bonusPath) in the
+     * background
+     */
+    void reloadBonus();
+
+    /**
+     * @brief swaps in the reloaded bonus level, keeping the player
+     * where it is if that cell is still free
+     *
+     * a file with errors is dropped, the current level goes on
+     * and the error is shown under the board for a few seconds
+     *
+     * @param wait if false, returns at once if it is not finished
+     */
+    void collectReload(bool wait);
+
     /**
      * @brief finds the next incomplete level
      */
@@ -182,8 +335,21 @@ private:
 
 
 public:
-    Game();
+    /**
+     * @brief creates the game
+     *
+     * @param pack if not null the classic levels are read from
+     * its first MAX_LEVEL_SIZE entries, it must stay open
+     * while the game exists
+     */
+    Game(const LevelPack* pack = nullptr);
     ~Game();
+
+    /**
+     * @brief if on, bonus mode reloads its file when it is saved
+     */
+    void setHotReload(bool on);
+
     void run(); 
 };
 
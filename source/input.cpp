@@ -0,0 +1,143 @@
+/**
+ * @file input.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief input.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "input.hpp"
+#include "profiler.hpp"
+
+#include <atomic>
+#include <ncurses.h>
+#include <poll.h>
+#include <unistd.h>
+
+int Input::waitKey(int timeoutMs) {
+    nodelay(stdscr, TRUE);
+
+    // keys already read by ncurses (the rest of an
+    // escape sequence, ungetch()) never reach poll()
+    int ch = getch();
+    if (ch != ERR){
+        return ch;
+    }
+
+    struct pollfd p;
+    p.fd = STDIN_FILENO;
+    p.events = POLLIN;
+    p.revents = 0;
+
+    if (poll(&p, 1, timeoutMs) == 0){
+        return ERR;
+    }
+
+    // input, or a signal: SIGWINCH becomes KEY_RESIZE
+    return getch();
+}
+
+// SECTION EVENT QUEUE
+
+// events are written by drain() at head and read
+// by pop() at tail, both only grow
+static Input::Event g_events[Input::QUEUE_SLOTS];
+static std::atomic<unsigned long> g_head(0);
+static std::atomic<unsigned long> g_tail(0);
+
+// keys are indexed by key code (KEY_MAX is 0777)
+static const int KEY_TABLE = 512;
+
+// last collapse() that returned each key
+static unsigned long g_keyTick[KEY_TABLE];
+static unsigned long g_tick = 0;
+
+static bool isArrow(int key) {
+    return key == KEY_UP || key == KEY_DOWN ||
+    key == KEY_LEFT || key == KEY_RIGHT;
+}
+
+int Input::drain() {
+    nodelay(stdscr, TRUE);
+
+    int queued = 0;
+    while (true) {
+        unsigned long h = g_head.load(std::memory_order_relaxed);
+        unsigned long t = g_tail.load(std::memory_order_acquire);
+        if (h - t >= (unsigned long)Input::QUEUE_SLOTS){
+            break;
+        }
+
+        int ch = getch();
+        if (ch == ERR){
+            break;
+        }
+
+        Input::Event& e = g_events[h % Input::QUEUE_SLOTS];
+        e.key = ch;
+        g_head.store(h + 1, std::memory_order_release);
+        queued++;
+    }
+
+    Profiler::bump(Profiler::Counter::INPUT_EVENTS,
+    (unsigned long long)queued);
+    return queued;
+}
+
+bool Input::pop(Input::Event& e) {
+    unsigned long t = g_tail.load(std::memory_order_relaxed);
+    unsigned long h = g_head.load(std::memory_order_acquire);
+    if (t == h){
+        return false;
+    }
+
+    e = g_events[t % Input::QUEUE_SLOTS];
+    g_tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+int Input::collapse(int* keys, int max) {
+    Input::Event tickEvents[Input::QUEUE_SLOTS];
+    int n = 0;
+    while (n < Input::QUEUE_SLOTS && Input::pop(tickEvents[n])) {
+        n++;
+    }
+
+    g_tick++;
+
+    // only the newest arrow is kept, it is the current intent
+    int newestArrow = -1;
+    for (int i = 0; i < n; i++) {
+        if (isArrow(tickEvents[i].key)){
+            newestArrow = i;
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < n && count < max; i++) {
+        int k = tickEvents[i].key;
+
+        if (isArrow(k) && i != newestArrow){
+            continue;
+        }
+
+        if (k >= 0 && k < KEY_TABLE) {
+            // auto-repeat, already returned in this tick
+            if (g_keyTick[k] == g_tick){
+                continue;
+            }
+            g_keyTick[k] = g_tick;
+        }
+
+        keys[count++] = k;
+    }
+
+    Profiler::bump(Profiler::Counter::INPUT_COLLAPSED,
+    (unsigned long long)(n - count));
+    return count;
+}
+
+//!SECTION
@@ -0,0 +1,104 @@
+/**
+ * @file input.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief keyboard input: blocking waits and per-tick sampling
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the Input class, used by the screens that only
+ * change on a key press or on an animation step: instead of polling
+ * getch() in a loop they sleep in poll() until a key arrives or the
+ * next step is due
+ *
+ * during gameplay the keys are sampled once per tick instead: every
+ * pending key is moved into a bounded queue of events, then the
+ * events of the tick are collapsed so that the auto-repeat of a held
+ * key can't pile up behind the game
+ *
+ * collapsing is per tick: the keys of a tick are read together, so
+ * a second press within a tick (33 ms) looks like auto-repeat and
+ * counts once
+ *
+ */
+
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+/**
+ * @brief static keyboard helpers on top of ncurses
+ */
+class Input {
+public:
+    /**
+     * @brief timeout of waitKey() that never expires
+     */
+    static const int WAIT_FOREVER = -1;
+
+    /**
+     * @brief number of events the queue can hold
+     */
+    static const int QUEUE_SLOTS = 64;
+
+    /**
+     * @brief max number of keys returned by collapse()
+     */
+    static const int MAX_TICK_KEYS = 16;
+
+    /**
+     * @brief a key read from the terminal
+     */
+    struct Event {
+        int key; // as getch()
+    };
+
+    /**
+     * @brief waits for a key for at most timeoutMs milliseconds
+     *
+     * the process sleeps while waiting; a terminal resize wakes it
+     * up and is returned as KEY_RESIZE
+     *
+     * leaves stdscr in nodelay mode
+     *
+     * @param timeoutMs max wait, WAIT_FOREVER to wait for a key
+     * @return the key (as getch()), ERR on timeout
+     */
+    static int waitKey(int timeoutMs);
+
+    /**
+     * @brief moves every pending key into the event queue
+     *
+     * never blocks; if the queue is full the remaining keys stay
+     * in ncurses until the next call
+     *
+     * leaves stdscr in nodelay mode
+     *
+     * @return the number of queued events
+     */
+    static int drain();
+
+    /**
+     * @brief removes the oldest event from the queue
+     *
+     * drain() and pop() may run on different threads, one each
+     *
+     * @return false if the queue is empty
+     */
+    static bool pop(Input::Event& e);
+
+    /**
+     * @brief empties the queue and returns the keys of one tick
+     *
+     * the arrow keys are reduced to the newest one, every other
+     * key is returned once per tick even if it was repeated (or
+     * pressed twice); the keys keep the order in which they arrived
+     *
+     * @param keys output array
+     * @param max size of keys
+     * @return the number of keys written
+     */
+    static int collapse(int* keys, int max);
+};
+
+#endif
@@ -10,6 +10,11 @@
  */
 
 #include "leaderboard.hpp"
+#include "alloc_tracker.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
 
 static int stringToInteger(const char* s) {
     if (s == nullptr) {
@@ -52,90 +57,422 @@ static int stringToInteger(const char* s) {
 }
 
 
-Leaderboard::Leaderboard(){
+/**
+ * @brief true if a comes before b: higher score, then name order
+ */
+static bool ranksBefore(const Leaderboard::ScoreEntry& a,
+const Leaderboard::ScoreEntry& b) {
+    if (a.score != b.score){
+        return a.score > b.score;
+    }
+    return strcmp(a.name, b.name) < 0;
+}
+
+// first table size for best scores, a power of two
+static const int BEST_CAPACITY = 64;
+
+// a name packed in a key, never 0
+static std::uint32_t nameKey(const char name[4]) {
+    return (std::uint32_t)(unsigned char)name[0] |
+    (std::uint32_t)(unsigned char)name[1] << 8 |
+    (std::uint32_t)(unsigned char)name[2] << 16 | 1u << 24;
+}
+
+static int slotOf(std::uint32_t key, int capacity) {
+    // multiplicative hashing, the high bits folded into the low
+    // ones the mask keeps (capacity is a power of two)
+    std::uint32_t h = key * 2654435761u;
+    h ^= h >> 16;
+    return (int)(h & (std::uint32_t)(capacity - 1));
+}
+
+Leaderboard::Leaderboard() : priorities(0x5C07EB0A4Dull) {
+    this->nodes = nullptr;
     this->count = 0;
+    this->capacity = 0;
+    this->root = -1;
+    this->best = nullptr;
+    this->names = 0;
+    this->bestCapacity = 0;
+    this->log = nullptr;
+}
+
+Leaderboard::~Leaderboard() {
+    this->close();
+    delete[] this->nodes;
+    delete[] this->best;
+}
+
+bool Leaderboard::open(const char* path, ScoreLog::Sync sync) {
+    this->close();
+
+    this->log = new ScoreLog();
+    if (!this->log->open(path, sync)) {
+        delete this->log;
+        this->log = nullptr;
+        this->load(path);
+        return false;
+    }
+    this->log->reload(*this);
+    return true;
+}
+
+void Leaderboard::close() {
+    if (this->log == nullptr){
+        return;
+    }
+    delete this->log; // compacts a last time
+    this->log = nullptr;
+}
+
+bool Leaderboard::submit(const char name[4], int score) {
+    if (this->log == nullptr){
+        this->add(name, score);
+        return false;
+    }
+    // read back by refresh(), with the records of other games
+    return this->log->append(name, score);
+}
+
+bool Leaderboard::refresh() {
+    if (this->log == nullptr){
+        return false;
+    }
+    return this->log->reload(*this);
 }
 
 int Leaderboard::size() const {
     return this->count;
 }
 
-void Leaderboard::add(const char name[4], int score) {
-    if (this->count < Leaderboard::MAX) {
-        this->entries[this->count].name[0] = name[0];
-        this->entries[this->count].name[1] = name[1];
-        this->entries[this->count].name[2] = name[2];
-        this->entries[this->count].name[3] = '\0';
-        this->entries[this->count].score = score;
-        this->count++;
-        this->sortDesc();
+void Leaderboard::clear() {
+    this->count = 0;
+    this->root = -1;
+    this->names = 0;
+    for (int i = 0; i < this->bestCapacity; i++) {
+        this->best[i].key = 0;
+    }
+}
+
+int Leaderboard::newNode(const char name[4], int score) {
+    if (this->count == this->capacity) {
+        AllocTracker::Scope tag(AllocTracker::Tag::LEADERBOARD);
+        int grown = this->capacity > 0 ? this->capacity * 2 : 64;
+        Leaderboard::Node* n = new Leaderboard::Node[grown];
+        if (this->count > 0){
+            memcpy(n, this->nodes, sizeof(Node) * (std::size_t)this->count);
+        }
+        delete[] this->nodes;
+        this->nodes = n;
+        this->capacity = grown;
+    }
+
+    Leaderboard::Node& n = this->nodes[this->count];
+    n.entry.name[0] = name[0];
+    n.entry.name[1] = name[1];
+    n.entry.name[2] = name[2];
+    n.entry.name[3] = '\0';
+    n.entry.score = score;
+    n.left = -1;
+    n.right = -1;
+    n.size = 1;
+    n.priority = (std::uint32_t)this->priorities.next();
+
+    this->updateBest(name, score);
+    return this->count++;
+}
+
+int Leaderboard::sizeOf(int node) const {
+    return node < 0 ? 0 : this->nodes[node].size;
+}
+
+void Leaderboard::split(int t, const Leaderboard::ScoreEntry& e,
+int& left, int& right) {
+    if (t < 0) {
+        left = -1;
+        right = -1;
         return;
     }
 
-    if (score <= this->entries[this->count - 1].score){
+    Leaderboard::Node& n = this->nodes[t];
+    if (ranksBefore(e, n.entry)) {
+        this->split(n.left, e, left, n.left);
+        right = t;
+    } else {
+        this->split(n.right, e, n.right, right);
+        left = t;
+    }
+    n.size = this->sizeOf(n.left) + this->sizeOf(n.right) + 1;
+}
+
+int Leaderboard::insert(int t, int node) {
+    Leaderboard::Node& n = this->nodes[node];
+    if (t < 0){
+        return node;
+    }
+
+    if (n.priority > this->nodes[t].priority) {
+        // node takes the place of t, t is split below it
+        this->split(t, n.entry, n.left, n.right);
+        n.size = this->sizeOf(n.left) + this->sizeOf(n.right) + 1;
+        return node;
+    }
+
+    // after the entries equal to it, as a stable sort would
+    Leaderboard::Node& at = this->nodes[t];
+    if (ranksBefore(n.entry, at.entry)) {
+        at.left = this->insert(at.left, node);
+    } else {
+        at.right = this->insert(at.right, node);
+    }
+    at.size++;
+    return t;
+}
+
+void Leaderboard::add(const char name[4], int score) {
+    int node = this->newNode(name, score);
+    this->root = this->insert(this->root, node);
+}
+
+void Leaderboard::buildSorted() {
+    if (this->count == 0){
+        this->root = -1;
         return;
     }
 
-    this->entries[this->count - 1].name[0] = name[0];
-    this->entries[this->count - 1].name[1] = name[1];
-    this->entries[this->count - 1].name[2] = name[2];
-    this->entries[this->count - 1].name[3] = '\0';
-    this->entries[this->count - 1].score = score;
+    // right spine of the tree built so far, priorities decreasing
+    int* spine = new int[this->count];
+    int depth = 0;
 
-    this->sortDesc();
+    for (int i = 0; i < this->count; i++) {
+        Leaderboard::Node& n = this->nodes[i];
+        int last = -1;
+        while (depth > 0 &&
+        this->nodes[spine[depth - 1]].priority < n.priority) {
+            last = spine[--depth];
+        }
+        n.left = last;
+        n.right = -1;
+        if (depth > 0){
+            this->nodes[spine[depth - 1]].right = i;
+        }
+        spine[depth++] = i;
+    }
+
+    this->root = spine[0];
+    delete[] spine;
+    this->fixSizes(this->root);
 }
 
-void Leaderboard::sortDesc() {
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = 0; j < count - 1 - i; j++) {
-            bool swapNeeded = false;
+int Leaderboard::fixSizes(int t) {
+    if (t < 0){
+        return 0;
+    }
+    Leaderboard::Node& n = this->nodes[t];
+    n.size = this->fixSizes(n.left) + this->fixSizes(n.right) + 1;
+    return n.size;
+}
 
-            if (entries[j].score < entries[j + 1].score) {
-                swapNeeded = true;
-            } else if (entries[j].score == entries[j + 1].score) {
-                if (strcmp(entries[j].name, entries[j + 1].name) > 0) {
-                    swapNeeded = true;
-                }
-            }
+int Leaderboard::collect(int t, int skip, int n,
+Leaderboard::ScoreEntry* out) const {
+    if (t < 0 || n <= 0){
+        return 0;
+    }
+
+    const Leaderboard::Node& node = this->nodes[t];
+    const int leftSize = this->sizeOf(node.left);
+
+    // subtrees before skip are never visited
+    int copied = 0;
+    if (skip < leftSize){
+        copied = this->collect(node.left, skip, n, out);
+    }
+    if (skip <= leftSize && copied < n){
+        out[copied++] = node.entry;
+    }
+    if (copied < n) {
+        int rest = skip - leftSize - 1;
+        copied += this->collect(node.right, rest > 0 ? rest : 0,
+        n - copied, out + copied);
+    }
+    return copied;
+}
+
+int Leaderboard::range(int first, int n,
+Leaderboard::ScoreEntry* out) const {
+    if (first < 0 || first >= this->count){
+        return 0;
+    }
+    return this->collect(this->root, first, n, out);
+}
 
-            if (swapNeeded) {
-                Leaderboard::ScoreEntry tmp = entries[j];
-                entries[j] = entries[j + 1];
-                entries[j + 1] = tmp;
+int Leaderboard::rankOf(int score) const {
+    int higher = 0;
+    int t = this->root;
+    while (t >= 0) {
+        const Leaderboard::Node& n = this->nodes[t];
+        if (n.entry.score > score) {
+            higher += this->sizeOf(n.left) + 1;
+            t = n.right;
+        } else {
+            t = n.left;
+        }
+    }
+    return higher + 1;
+}
+
+void Leaderboard::updateBest(const char name[4], int score) {
+    // grown at 3/4 full
+    if ((this->names + 1) * 4 > this->bestCapacity * 3) {
+        AllocTracker::Scope tag(AllocTracker::Tag::LEADERBOARD);
+        int grown = this->bestCapacity > 0 ? this->bestCapacity * 2 :
+        BEST_CAPACITY;
+        Leaderboard::Best* b = new Leaderboard::Best[grown];
+        for (int i = 0; i < grown; i++) {
+            b[i].key = 0;
+        }
+        for (int i = 0; i < this->bestCapacity; i++) {
+            if (this->best[i].key == 0){
+                continue;
             }
+            int slot = slotOf(this->best[i].key, grown);
+            while (b[slot].key != 0) {
+                slot = (slot + 1) & (grown - 1);
+            }
+            b[slot] = this->best[i];
         }
+        delete[] this->best;
+        this->best = b;
+        this->bestCapacity = grown;
+    }
+
+    const std::uint32_t key = nameKey(name);
+    int slot = slotOf(key, this->bestCapacity);
+    while (this->best[slot].key != 0 && this->best[slot].key != key) {
+        slot = (slot + 1) & (this->bestCapacity - 1);
+    }
+
+    Leaderboard::Best& b = this->best[slot];
+    if (b.key == 0) {
+        b.key = key;
+        b.score = score;
+        this->names++;
+    } else if (score > b.score) {
+        b.score = score;
     }
 }
 
+bool Leaderboard::bestOf(const char name[4], int& score) const {
+    if (this->names == 0){
+        return false;
+    }
+
+    const std::uint32_t key = nameKey(name);
+    int slot = slotOf(key, this->bestCapacity);
+    while (this->best[slot].key != 0) {
+        if (this->best[slot].key == key) {
+            score = this->best[slot].score;
+            return true;
+        }
+        slot = (slot + 1) & (this->bestCapacity - 1);
+    }
+    return false;
+}
+
 bool Leaderboard::save(const char* path) const {
-    std::ofstream out(path);
-    if (!out.is_open()){
+    return ScoreLog::replace(path, *this);
+}
+
+bool Leaderboard::load(const char* path) {
+    return ScoreLog::read(path, *this);
+}
+
+bool Leaderboard::saveSnapshot(const char* path,
+std::uint64_t generation, std::uint32_t records) const {
+    AllocTracker::Scope tag(AllocTracker::Tag::LEADERBOARD);
+
+    // beside the snapshot, one per process
+    char tmp[ScoreLog::PATH_SIZE + 32];
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, (int)getpid());
+
+    FILE* out = fopen(tmp, "w");
+    if (out == nullptr){
         return false;
     }
 
-    for (int i = 0; i < count; i++) {
-        out << entries[i].name << ";" << entries[i].score << "\n";
+    // a comment for the old loader, the log mark for the new one
+    fprintf(out, "# log %llu %u\n", (unsigned long long)generation,
+    (unsigned)records);
+    // a page at a time, in rank order
+    Leaderboard::ScoreEntry page[256];
+    for (int first = 0; first < this->count; ) {
+        int n = this->range(first, 256, page);
+        for (int i = 0; i < n; i++) {
+            fprintf(out, "%s;%d\n", page[i].name, page[i].score);
+        }
+        first += n;
     }
 
-    out.close();
+    bool ok = fflush(out) == 0 && fsync(fileno(out)) == 0;
+    ok = fclose(out) == 0 && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return false;
+    }
     return true;
 }
 
-bool Leaderboard::load(const char* path) {
+bool Leaderboard::loadMark(const char* path, std::uint64_t* generation,
+std::uint32_t* records) {
+    *generation = 0;
+    *records = 0;
+
+    FILE* in = fopen(path, "r");
+    if (in == nullptr){
+        return false;
+    }
+
+    unsigned long long g = 0;
+    unsigned r = 0;
+    if (fscanf(in, "# log %llu %u", &g, &r) == 2) {
+        *generation = (std::uint64_t)g;
+        *records = (std::uint32_t)r;
+    }
+    fclose(in);
+    return true;
+}
+
+bool Leaderboard::loadSnapshot(const char* path,
+std::uint64_t* generation, std::uint32_t* records) {
+    AllocTracker::Scope tag(AllocTracker::Tag::LEADERBOARD);
+
+    this->clear();
+    *generation = 0;
+    *records = 0;
+
     std::ifstream in(path);
     if (!in.is_open()){
         return false;
     }
 
-    count = 0;
-
     char line[64];
+    bool sorted = true;
 
     while (in.getline(line, sizeof(line))) {
         if (line[0] == '\0'){
             continue;
         }
 
+        if (line[0] == '#') {
+            unsigned long long g = 0;
+            unsigned r = 0;
+            if (sscanf(line, "# log %llu %u", &g, &r) == 2) {
+                *generation = (std::uint64_t)g;
+                *records = (std::uint32_t)r;
+            }
+            continue;
+        }
+
         // find ; separator
         char* sep = strchr(line, ';');
         if (sep == nullptr){
@@ -153,14 +490,41 @@ bool Leaderboard::load(const char* path) {
             name3[i] = nameStr[i];
         }
 
-        add(name3, score);
-        if (count >= MAX) break;
+        // linked below, once the order is known
+        int node = this->newNode(name3, score);
+        if (node > 0 && ranksBefore(this->nodes[node].entry,
+        this->nodes[node - 1].entry)){
+            sorted = false;
+        }
     }
 
     in.close();
+
+    if (sorted) {
+        this->buildSorted();
+        return true;
+    }
+    for (int i = 0; i < this->count; i++) {
+        this->nodes[i].left = -1;
+        this->nodes[i].right = -1;
+        this->nodes[i].size = 1;
+        this->root = this->insert(this->root, i);
+    }
     return true;
 }
 
 const Leaderboard::ScoreEntry& Leaderboard::at(int i) const {
-    return entries[i];
+    int t = this->root;
+    for (;;) {
+        const Leaderboard::Node& n = this->nodes[t];
+        const int leftSize = this->sizeOf(n.left);
+        if (i < leftSize) {
+            t = n.left;
+        } else if (i == leftSize) {
+            return n.entry;
+        } else {
+            i -= leftSize + 1;
+            t = n.right;
+        }
+    }
 }
@@ -12,31 +12,43 @@
  * 
  * it is used to keep track of player names and scores
  * across multiple game sessions
+ *
+ * the file is a sorted snapshot plus a log of the scores added
+ * since, see ScoreLog
  * 
+ * the entries are kept in an order-statistic treap (a binary
+ * search tree, heap ordered by random priorities, where every node
+ * knows the size of its subtree): inserting, finding the k-th entry
+ * and the rank of a score take O(log n), so the table has no size
+ * limit and a page of it costs the same with millions of entries
+ *
  */
 
 #ifndef LEADERBOARD_HPP
 #define LEADERBOARD_HPP
 
+#include "random.hpp"
+#include "score_log.hpp"
+
+#include <cstdint>
 #include <cstring>
 #include <ncurses.h>
-#include <fstream>
 
 
 /**
  * @brief manages the game leaderboard
  *
- * this class stores player scores with a fixed maximum size
- * it supports adding new entries, sorting them,
- * and saving or loading the leaderboard from a file
+ * this class stores player scores, highest first (same scores
+ * by name, then in insertion order)
+ * it supports adding new entries, rank and page queries, the
+ * best score of a player, and saving or loading the leaderboard
+ * from a file
  */
 class Leaderboard {
-public:
-    /**
-     * @brief maximum number of leaderboard entries
-     */
-    static const int MAX = 50;
+    // reads and writes snapshots while it compacts
+    friend class ScoreLog;
 
+public:
     /**
      * @brief single leaderboard entry
      *
@@ -47,10 +59,128 @@ public:
         int score;
     };
 private:
-    // array of leaderboard entries
-    Leaderboard::ScoreEntry entries[Leaderboard::MAX];
+    /**
+     * @brief a treap node, children are indexes in nodes (-1: none)
+     */
+    struct Node {
+        Leaderboard::ScoreEntry entry;
+        int left;
+        int right;
+        int size;               // nodes in this subtree
+        std::uint32_t priority; // larger than the children's
+    };
+
+    /**
+     * @brief best score of a name, key 0 is a free slot
+     */
+    struct Best {
+        std::uint32_t key;
+        int score;
+    };
+
+    // every node, in insertion order (never removed one by one)
+    Leaderboard::Node* nodes;
     // current number of entries
     int count;
+    int capacity;
+    int root;
+
+    // open addressing table of the best score of each name
+    Leaderboard::Best* best;
+    int names;
+    int bestCapacity;
+
+    // node priorities
+    Random priorities;
+
+    // log of the file opened with open(), nullptr if none
+    ScoreLog* log;
+
+    /**
+     * @brief removes every entry, keeping the memory
+     */
+    void clear();
+
+    /**
+     * @brief stores an entry as a new node, not linked yet
+     *
+     * @return the index of the node
+     */
+    int newNode(const char name[4], int score);
+
+    /**
+     * @brief size of the subtree at node, 0 for -1
+     */
+    int sizeOf(int node) const;
+
+    /**
+     * @brief links node under t, returns the new root of t
+     */
+    int insert(int t, int node);
+
+    /**
+     * @brief splits t into the nodes that rank before e or tie
+     * with it (left) and the ones that rank after it (right)
+     */
+    void split(int t, const Leaderboard::ScoreEntry& e, int& left,
+    int& right);
+
+    /**
+     * @brief links nodes 0..count-1, already in rank order, in O(n)
+     */
+    void buildSorted();
+
+    /**
+     * @brief sets the subtree sizes below t, returns the one of t
+     */
+    int fixSizes(int t);
+
+    /**
+     * @brief copies up to n entries of the subtree t, skipping its
+     * first skip ones
+     *
+     * @return the number of entries copied
+     */
+    int collect(int t, int skip, int n, Leaderboard::ScoreEntry* out)
+    const;
+
+    /**
+     * @brief raises the best score of name to score
+     */
+    void updateBest(const char name[4], int score);
+
+    /**
+     * @brief reads a snapshot file, replacing the entries
+     *
+     * a sorted file (the ones saveSnapshot() writes) is linked in
+     * O(n), any other is inserted entry by entry
+     *
+     * @param generation set to the log generation the snapshot
+     * holds records of (0 if none)
+     * @param records set to how many records of that log it holds
+     * @return false if the file cannot be opened
+     */
+    bool loadSnapshot(const char* path, std::uint64_t* generation,
+    std::uint32_t* records);
+
+    /**
+     * @brief reads the log mark of a snapshot file (its first line)
+     * without reading the entries
+     *
+     * @return false if the file cannot be opened
+     */
+    static bool loadMark(const char* path, std::uint64_t* generation,
+    std::uint32_t* records);
+
+    /**
+     * @brief writes the entries as a snapshot file
+     *
+     * the file is written aside, synced and renamed over path, a
+     * reader sees the old snapshot or the new one
+     */
+    bool saveSnapshot(const char* path, std::uint64_t generation,
+    std::uint32_t records) const;
+
 public:
     /**
      * @brief constructs an empty leaderboard
@@ -58,34 +188,95 @@ public:
     Leaderboard();
 
     /**
-     * @brief adds a new entry to the leaderboard
+     * @brief closes the file opened with open()
+     */
+    ~Leaderboard();
+
+    // owns its nodes and its log
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    /**
+     * @brief loads the score file and keeps it open for submit()
      *
-     * if the leaderboard is full, the entry may be flushed
-     * depending on its score
+     * a background thread compacts its log (see ScoreLog)
+     *
+     * @param sync when submitted scores reach the disk
+     * @return false if the log cannot be opened (the entries
+     * are loaded anyway)
      */
-    void add(const char name[4], int score);
+    bool open(const char* path,
+    ScoreLog::Sync sync = ScoreLog::Sync::ALWAYS);
+
+    /**
+     * @brief closes the file opened with open()
+     */
+    void close();
 
     /**
-     * @brief sorts the leaderboard in descending order
+     * @brief appends an entry to the open file
+     *
+     * a single record is written, the file is never rewritten here;
+     * the entry is read back with the others by refresh()
      *
-     * highest scores will appear first, as it should be
+     * @return false if no file is open (the entry is added
+     * directly) or the record was not written
      */
-    void sortDesc();
+    bool submit(const char name[4], int score);
+
+    /**
+     * @brief reads the scores added to the open file since the
+     * last refresh, by this game or others
+     *
+     * only the new log records are read, unless the file was
+     * compacted in the meantime
+     */
+    bool refresh();
+
+    /**
+     * @brief adds a new entry to the leaderboard in O(log n)
+     */
+    void add(const char name[4], int score);
+
     /**
      * @brief returns the number of stored entries
      */
     int size() const;
 
     /**
-     * @brief returns a reference to an entry by index
+     * @brief returns a reference to an entry by index, in O(log n)
      *
      * the index must be valid
      */    
     const Leaderboard::ScoreEntry& at(int i) const;
 
+    /**
+     * @brief copies the entries first..first+n-1 into out
+     *
+     * O(log n + n), what a leaderboard page needs
+     *
+     * @return the number of entries copied, less than n at the end
+     */
+    int range(int first, int n, Leaderboard::ScoreEntry* out) const;
+
+    /**
+     * @brief returns the rank (from 1) of a score: one more than
+     * the number of entries with a higher score, in O(log n)
+     */
+    int rankOf(int score) const;
+
+    /**
+     * @brief looks up the best score of a player
+     *
+     * @return false if the name has no entry
+     */
+    bool bestOf(const char name[4], int& score) const;
+
     /**
      * @brief loads the leaderboard from a file
      *
+     * the snapshot is read, then the log records it doesn't hold
+     *
      * returns false if the file cannot be opened or read
      */
     bool load(const char* path);
@@ -93,9 +284,12 @@ public:
     /**
      * @brief saves the leaderboard to a file
      *
+     * the snapshot is replaced and its log emptied, scores other
+     * games logged since the last load are lost (use submit())
+     *
      * returns false if the method fails
      */   
     bool save(const char* path) const;
 };
 
-#endif 
\ No newline at end of file
+#endif 
@@ -11,16 +11,37 @@
 
 #include "level.hpp"
 
+#ifdef DEBUG_MODE
+#include <cassert>
+#include <utility>
+#endif
+
 Level::Level(Player* p, unsigned short w, 
-unsigned short h, Map& map) : 
+unsigned short h, const Map& map) : 
 board(w, h), player(p) {
+    this->setup();
+    load(map);
+}
+
+Level::Level(Player* p, unsigned short w,
+unsigned short h, const LevelPack::Entry& entry) :
+board(w, h), player(p) {
+    this->setup();
+    load(entry);
+}
+
+void Level::setup() {
     if (player == nullptr) {
         throw Level::InvalidPlayerException();
     }
     
     rng.setSeed(Random::newSeed());
 
-    load(map);
+    AllocTracker::Scope tag(AllocTracker::Tag::LEVEL);
+
+    // the lists never grow past the pools
+    this->bombs.reserve(MAX_BOMBS);
+    this->powerUps.reserve(MAX_POWERUPS);
 }
 
 bool Level::isCompleted() const {
@@ -44,9 +65,16 @@ Board::CellType Level::tileToCell(_TileType t) {
     }
 }
 
-void Level::load(Map& map){
+template <typename E, typename... Args>
+void Level::spawnEnemy(Args&&... args) {
+    Enemy* e = this->enemyPool.create<E>(std::forward<Args>(args)...);
+    if (e == nullptr){
+        e = new E(std::forward<Args>(args)...);
+    }
+    this->enemies.push_back(e);
+}
 
-    this->player->setBoard(&board);
+void Level::load(const Map& map){
 
     this->completed = false;
 
@@ -54,110 +82,240 @@ void Level::load(Map& map){
 
     for (unsigned short y = 0; y < map.height(); y++) {
         for (unsigned short x = 0; x < map.width(); x++) {
-            _Tile t = map.at(x,y);
+            const _Tile& t = map.at(x,y);
+
+            AllocTracker::Scope tag(AllocTracker::Tag::ENEMY);
 
             if(t.getType() == _TileType::PATROLLER){
-                this->enemies.push_back(new Patroller(
-                    &this->board
-                    , t.getStartX(),
+                this->spawnEnemy<Patroller>(
+                    &this->board,
+                    t.getStartX(),
                     t.getStartY(),
                     t.getEndX(),
                     t.getEndY(),
-                    t.getSpeed()        
-                ));
+                    t.getSpeed()
+                );
             } else if (t.getType() == _TileType::WALKER) {
-                this->enemies.push_back(new Walker(
+                this->spawnEnemy<Walker>(
                     &this->board,
                     t.getStartX(),
                     t.getStartY(),
                     Random::newSeed(),
-                    t.getSpeed()  
-                ));
+                    t.getSpeed()
+                );
             } else if (t.getType() == _TileType::CHASER) {
-                this->enemies.push_back(new Chaser(
+                this->spawnEnemy<Chaser>(
                     &this->board,
                     this->player,
                     t.getStartX(),
                     t.getStartY(),
                     Random::newSeed(),
                     t.getSpeed()
-                ));                
-            } else if (t.getType()== _TileType::SPAWN){
-                this->spawnX = x;
-                this->spawnY = y;
-            } else if (t.getType() == _TileType::GATE_NEXT) {
-                board.setCell(x, y, Board::CellType::GATE_NEXT);
-                gateNextX = x; gateNextY = y;
-                hasGateNext = true;
-            } else if (t.getType() == _TileType::GATE_PREV) {
-                board.setCell(x, y, Board::CellType::GATE_PREV);
-                gatePrevX = x; gatePrevY = y;
-                hasGatePrev = true;
+                );
             } else {
-                this->board.setCell(x,y,Level::tileToCell(t.getType()));
+                this->loadTerrain(x, y, t.getType());
             }
         }
     }
 }
 
+void Level::loadTerrain(unsigned short x, unsigned short y, _TileType t) {
+    if (t == _TileType::SPAWN){
+        this->spawnX = x;
+        this->spawnY = y;
+    } else if (t == _TileType::GATE_NEXT) {
+        board.setCell(x, y, Board::CellType::GATE_NEXT);
+        gateNextX = x; gateNextY = y;
+        hasGateNext = true;
+    } else if (t == _TileType::GATE_PREV) {
+        board.setCell(x, y, Board::CellType::GATE_PREV);
+        gatePrevX = x; gatePrevY = y;
+        hasGatePrev = true;
+    } else {
+        this->board.setCell(x,y,Level::tileToCell(t));
+    }
+}
+
+void Level::load(const LevelPack::Entry& entry) {
+
+    this->completed = false;
+
+    this->board.clear();
+
+    const std::uint8_t* cell = entry.terrain;
+    for (unsigned short y = 0; y < entry.height; y++) {
+        for (unsigned short x = 0; x < entry.width; x++) {
+            // unknown values (damaged pack) load as EMPTY
+            _TileType t = *cell <= _TileType::GATE_PREV ?
+            (_TileType)*cell : _TileType::EMPTY;
+            this->loadTerrain(x, y, t);
+            cell++;
+        }
+    }
+
+    AllocTracker::Scope tag(AllocTracker::Tag::ENEMY);
+
+    for (unsigned int i = 0; i < entry.spawnCount; i++) {
+        const LevelPack::Spawn& s = entry.spawns[i];
+
+        if (s.type == _TileType::PATROLLER) {
+            this->spawnEnemy<Patroller>(
+                &this->board,
+                s.sx,
+                s.sy,
+                s.ex,
+                s.ey,
+                s.speed
+            );
+        } else if (s.type == _TileType::WALKER) {
+            this->spawnEnemy<Walker>(
+                &this->board,
+                s.sx,
+                s.sy,
+                Random::newSeed(),
+                s.speed
+            );
+        } else if (s.type == _TileType::CHASER) {
+            this->spawnEnemy<Chaser>(
+                &this->board,
+                this->player,
+                s.sx,
+                s.sy,
+                Random::newSeed(),
+                s.speed
+            );
+        }
+    }
+}
+
+void Level::releaseEntities() {
+    for(unsigned int i = 0; i < bombs.len(); i++){
+        this->bombPool.destroy(bombs.at(i));
+    }
+
+    for(unsigned int i = 0; i < enemies.len(); i++){
+        this->enemyPool.destroy(enemies.at(i));
+    }
+
+    for(unsigned int i = 0; i < powerUps.len(); i++){
+        this->powerUpPool.destroy(powerUps.at(i));
+    }
+
+    this->bombs.clear();
+    this->enemies.clear();
+    this->powerUps.clear();
+}
+
+void Level::reset(const Map& map) {
+    this->clearState();
+    this->load(map);
+}
+
+void Level::reset(const LevelPack::Entry& entry) {
+    this->clearState();
+    this->load(entry);
+}
+
+void Level::clearState() {
+    this->releaseEntities();
+
+    this->transition = Level::TransitionRequest::NONE;
+    this->gateNextX = 0;
+    this->gateNextY = 0;
+    this->gatePrevX = 0;
+    this->gatePrevY = 0;
+    this->hasGateNext = false;
+    this->hasGatePrev = false;
+    this->spawnX = 0;
+    this->spawnY = 0;
+}
+
 void Level::update() {
 
-    for (unsigned int i = 0; i < enemies.len(); i++) {
-        Enemy* e = enemies.at(i);
-        e->update();
+#ifdef DEBUG_MODE
+    const unsigned long long allocsBefore = AllocTracker::thread().count;
+#endif
+
+    this->tick();
+
+#ifdef DEBUG_MODE
+    assert(AllocTracker::thread().count == allocsBefore &&
+    "Level::update must not allocate");
+#endif
+}
+
+void Level::tick() {
+
+    {
+        Profiler::Scope scope(Profiler::Phase::ENEMIES);
+        for (unsigned int i = 0; i < enemies.len(); i++) {
+            Enemy* e = enemies.at(i);
+            e->update();
+        }
     }
 
     unsigned short px = player->getX();
     unsigned short py = player->getY();
 
-    for (unsigned int i = 0; i < this->enemies.len(); i++) {
-        Enemy* e = this->enemies.at(i);
-        if (e->getX() == px && e->getY() == py) {
-            this->player->takeDamage();
-                break;
+    {
+        Profiler::Scope scope(Profiler::Phase::COLLISIONS);
+        for (unsigned int i = 0; i < this->enemies.len(); i++) {
+            Enemy* e = this->enemies.at(i);
+            if (e->getX() == px && e->getY() == py) {
+                this->player->takeDamage();
+                    break;
+            }
         }
     }
 
-    for (unsigned int i = 0; i < this->bombs.len(); i++) {
-        Bomb* b = this->bombs.at(i);
-        b->update(this->enemies, this->powerUps, this->rng);
-    }
+    {
+        Profiler::Scope scope(Profiler::Phase::BOMBS);
+        for (unsigned int i = 0; i < this->bombs.len(); i++) {
+            Bomb* b = this->bombs.at(i);
+            b->update(this->enemies, this->enemyPool, this->powerUps,
+            this->powerUpPool, this->rng);
+        }
 
-    for (unsigned int i = 0; i < this->bombs.len(); ) {
-        Bomb* b = this->bombs.at(i);
-        if (!b->isPlaced()) {
-            this->bombs.remove(i);
-            delete b;
-        } else {
-            i++;
+        for (unsigned int i = 0; i < this->bombs.len(); ) {
+            Bomb* b = this->bombs.at(i);
+            if (!b->isPlaced()) {
+                this->bombs.remove(i);
+                this->bombPool.destroy(b);
+            } else {
+                i++;
+            }
         }
     }
 
-    for (unsigned int i = 0; i < powerUps.len(); ) {
-        PowerUp* pu = powerUps.at(i);
-        if (!pu) { 
-            powerUps.remove(i); 
-            continue; 
-        }
+    {
+        Profiler::Scope scope(Profiler::Phase::POWERUPS);
+        for (unsigned int i = 0; i < powerUps.len(); ) {
+            PowerUp* pu = powerUps.at(i);
+            if (!pu) { 
+                powerUps.remove(i); 
+                continue; 
+            }
 
-        pu->update();
+            pu->update();
 
-        // give powerup effect and remove from list
-        if (pu->getX() == player->getX() && pu->getY() == player->getY()) {
-            pu->apply(*player);
-            delete pu;
-            powerUps.remove(i);
-            continue;
-        }
+            // give powerup effect and remove from list
+            if (pu->getX() == player->getX() && 
+            pu->getY() == player->getY()) {
+                pu->apply(*player);
+                this->powerUpPool.destroy(pu);
+                powerUps.remove(i);
+                continue;
+            }
 
-        // despawn if expired
-        if (pu->isExpired()) {
-            delete pu;
-            this->powerUps.remove(i);
-            continue;
-        }
+            // despawn if expired
+            if (pu->isExpired()) {
+                this->powerUpPool.destroy(pu);
+                this->powerUps.remove(i);
+                continue;
+            }
 
-        i++;
+            i++;
+        }
     }
 
     Board::CellType under = this->board.getCell(px, py);
@@ -171,8 +329,11 @@ void Level::update() {
         return;
     }
 
+    {
+        Profiler::Scope scope(Profiler::Phase::EXPLOSIONS);
+        this->board.updateExplosions();
+    }
 
-    this->board.updateExplosions();
     this->player->updateInvulnerability();
     this->player->updateTimers();
 
@@ -198,17 +359,19 @@ void Level::placeBomb() {
     Bomb* b = nullptr;
 
     try {
-        b = new Bomb(&board, player, 90, 
+        b = this->bombPool.create<Bomb>(&board, player, 90, 
         player->getBombRange());
     } catch (...) {
-        if (b != nullptr){
-            delete b;
-        }
+        return;
+    }
+
+    // every slot in use
+    if (b == nullptr) {
         return;
     }
 
     if (!b->isPlaced()) {
-        delete b;
+        this->bombPool.destroy(b);
         return;
     }
 
@@ -221,13 +384,17 @@ void Level::onEnter(Level::TransitionRequest from) {
     player->setSpawn(this->spawnX,this->spawnY);
     this->transition = Level::TransitionRequest::NONE;
 
-    if (from == Level::TransitionRequest::NEXT) {
+    // bonus levels need only one gate, without it (or without room
+    // beside it) the player starts at spawn
+    if (from == Level::TransitionRequest::NEXT && this->hasGatePrev &&
+    gatePrevX + 1 < board.getWidth()) {
         player->setX(gatePrevX + 1);
         player->setY(gatePrevY);
         return;
     }
 
-    if (from == Level::TransitionRequest::PREV) {
+    if (from == Level::TransitionRequest::PREV && this->hasGateNext &&
+    gateNextX > 0) {
         player->setX(gateNextX - 1);
         player->setY(gateNextY);
         return;
@@ -258,33 +425,7 @@ const list<PowerUp*>& Level::getPowerUps() const {
 }
 
 Level::~Level(){
-    for(unsigned int i = 0; i < bombs.len(); i++){
-        Bomb* b = bombs.at(i);
-        if(b != nullptr){
-            delete b;
-        }
-        b = nullptr;
-    }
-
-    for(unsigned int i = 0; i < enemies.len(); i++){
-        Enemy* e = enemies.at(i);
-        if(e != nullptr){
-            delete e;
-        }
-        e = nullptr;
-    }
-
-    for(unsigned int i = 0; i < powerUps.len(); i++){
-        PowerUp* pu = powerUps.at(i);
-        if(pu != nullptr){
-            delete pu;
-        }
-        pu = nullptr;        
-    }
-    
-    this->bombs.clear();
-    this->enemies.clear();
-    this->powerUps.clear();
+    this->releaseEntities();
 }
 
 unsigned short Level::getSpawnX() const{
@@ -314,7 +455,7 @@ void Level::onExit(){
                     }
                 } catch (...) { }
             }
-            delete b; // delete the bomb
+            this->bombPool.destroy(b); // destroy the bomb
         }
         this->bombs.remove(i); // and remove it from list
     }  
@@ -326,10 +467,7 @@ void Level::onExit(){
 // it's the K key
 void Level::killAllEnemies() {
     for (unsigned int i = 0; i < enemies.len(); i++) {
-        Enemy* e = enemies.at(i);
-        if (e != nullptr) {
-            delete e;
-        }
+        this->enemyPool.destroy(enemies.at(i));
     }
     enemies.clear();
 
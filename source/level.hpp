@@ -28,8 +28,11 @@
 #include "bomb.hpp"
 #include "enemies.hpp"
 #include "maps.hpp"
+#include "levelpack.hpp"
 #include "random.hpp"
 #include "powerup.hpp"
+#include "profiler.hpp"
+#include "alloc_tracker.hpp"
 
 #include <exception>
 
@@ -75,6 +78,12 @@ private:
     // powerups on the ground
     list<PowerUp*> powerUps;
 
+    // storage the enemies, bombs and powerups are built in,
+    // placing, dropping and resetting never touch the heap
+    EnemyPool enemyPool;
+    BombPool bombPool;
+    PowerUpPool powerUpPool;
+
     // rng used for drops
     Random rng;
 
@@ -108,6 +117,9 @@ public:
      * the level creates its board, loads tiles and entities from the map,
      * and stores spawn and gate positions
      *
+     * the player is not touched until onEnter(), so a level can be
+     * built on another thread while the current one is played
+     *
      * @param p player pointer used by the level
      * @param w board width
      * @param h board height
@@ -115,7 +127,35 @@ public:
      * @throws InvalidPlayerException if p is null
      */
     Level(Player* p, unsigned short w,
-    unsigned short h, Map& map);
+    unsigned short h, const Map& map);
+
+    /**
+     * @brief builds a level from a level pack entry
+     *
+     * same as the Map constructor, tiles and enemies are read
+     * straight from the pack mapping
+     *
+     * @param entry level of an open pack, same size as the board
+     * @throws InvalidPlayerException if p is null
+     */
+    Level(Player* p, unsigned short w,
+    unsigned short h, const LevelPack::Entry& entry);
+
+    /**
+     * @brief brings the level back to its initial state
+     *
+     * terrain, gates, spawn and enemies are reloaded from the map
+     * into the storage the level already owns, a reset doesn't
+     * allocate unless the map has more enemies than before
+     *
+     * @param map source map data, same size as the board
+     */
+    void reset(const Map& map);
+
+    /**
+     * @brief same as reset(const Map&), from a level pack entry
+     */
+    void reset(const LevelPack::Entry& entry);
 
 private:
     /**
@@ -123,7 +163,51 @@ private:
      *
      * this initializes board cells and spawns enemies based on map tiles
      */
-    void load(Map& map);
+    void load(const Map& map);
+
+    /**
+     * @brief loads tiles, enemies, gates and spawn from a pack entry
+     *
+     * the terrain and the spawn table are read in place, nothing
+     * is copied out of the pack first
+     */
+    void load(const LevelPack::Entry& entry);
+
+    /**
+     * @brief checks the player and prepares the entity storage,
+     * shared by the constructors
+     */
+    void setup();
+
+    /**
+     * @brief sets the board cell at (x,y) from a static tile type,
+     * recording spawn and gates
+     */
+    void loadTerrain(unsigned short x, unsigned short y, _TileType t);
+
+    /**
+     * @brief clears transition, gates and spawn before a reload
+     */
+    void clearState();
+
+    /**
+     * @brief builds an enemy in the pool, on the heap if it is full
+     */
+    template <typename E, typename... Args>
+    void spawnEnemy(Args&&... args);
+
+    /**
+     * @brief destroys every enemy, bomb and powerup of the level
+     *
+     * the list nodes and the pool slots are kept for reuse
+     */
+    void releaseEntities();
+
+    /**
+     * @brief body of update(), kept apart so the debug
+     * allocation check wraps every return path
+     */
+    void tick();
 public:
 
     /**
@@ -131,6 +215,8 @@ public:
      *
      * updates enemies, bombs, powerups and explosions
      * checks collisions with player and sets transition request if needed
+     *
+     * a tick never allocates, debug builds assert it
      */    
     void update();
 
@@ -0,0 +1,383 @@
+/**
+ * @file levelpack.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief levelpack.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "levelpack.hpp"
+#include "map_analyzer.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char PACK_MAGIC[4] = {'B', 'G', 'L', 'P'};
+
+// sections start at multiples of this, every record stays aligned
+static const std::uint32_t PACK_ALIGN = 4;
+
+static_assert(sizeof(LevelPack::Header) == 24, "pack header layout");
+static_assert(sizeof(LevelPack::IndexEntry) == 28, "pack index layout");
+static_assert(sizeof(LevelPack::Spawn) == 12, "pack spawn layout");
+
+LevelPack::LevelPack() :
+base(nullptr), length(0), header(nullptr), index(nullptr) {}
+
+LevelPack::~LevelPack() {
+    this->close();
+}
+
+void LevelPack::open(const char* path) {
+    this->close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0){
+        throw LevelPack::OpenException();
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw LevelPack::OpenException();
+    }
+
+    void* p = mmap(nullptr, (std::size_t)st.st_size, PROT_READ,
+    MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file alive
+    ::close(fd);
+    if (p == MAP_FAILED){
+        throw LevelPack::OpenException();
+    }
+
+    this->base = (const unsigned char*)p;
+    this->length = (std::size_t)st.st_size;
+
+    try {
+        this->validate();
+    } catch (...) {
+        this->close();
+        throw;
+    }
+
+    this->header = (const LevelPack::Header*)this->base;
+    this->index = (const LevelPack::IndexEntry*)
+    (this->base + this->header->indexOffset);
+}
+
+void LevelPack::validate() const {
+    if (this->length < sizeof(LevelPack::Header)){
+        throw LevelPack::FormatException();
+    }
+
+    const LevelPack::Header* h = (const LevelPack::Header*)this->base;
+    if (memcmp(h->magic, PACK_MAGIC, 4) != 0 ||
+    h->version != LevelPack::VERSION ||
+    h->fileSize != this->length ||
+    h->width == 0 || h->height == 0) {
+        throw LevelPack::FormatException();
+    }
+
+    // 64 bit sums, a damaged offset can't wrap around
+    const std::uint64_t size = this->length;
+    const std::uint64_t cells = (std::uint64_t)h->width * h->height;
+
+    if (h->indexOffset % alignof(LevelPack::IndexEntry) != 0 ||
+    (std::uint64_t)h->indexOffset +
+    (std::uint64_t)h->levelCount * sizeof(LevelPack::IndexEntry) > size) {
+        throw LevelPack::FormatException();
+    }
+
+    const LevelPack::IndexEntry* entries = (const LevelPack::IndexEntry*)
+    (this->base + h->indexOffset);
+
+    for (std::uint32_t i = 0; i < h->levelCount; i++) {
+        const LevelPack::IndexEntry& e = entries[i];
+
+        if ((std::uint64_t)e.terrainOffset + cells > size){
+            throw LevelPack::FormatException();
+        }
+
+        if (e.spawnOffset % alignof(LevelPack::Spawn) != 0 ||
+        (std::uint64_t)e.spawnOffset +
+        (std::uint64_t)e.spawnCount * sizeof(LevelPack::Spawn) > size) {
+            throw LevelPack::FormatException();
+        }
+
+        if (e.name[LevelPack::NAME_SIZE - 1] != '\0'){
+            throw LevelPack::FormatException();
+        }
+
+        this->validateLevel(e);
+    }
+}
+
+void LevelPack::validateLevel(const LevelPack::IndexEntry& e) const {
+    const LevelPack::Header* h = (const LevelPack::Header*)this->base;
+    const std::uint8_t* terrain = this->base + e.terrainOffset;
+    const int w = h->width;
+    const int hh = h->height;
+
+    // the rules MapAnalyzer reports as errors: a SOLID border (Board
+    // throws past it, and Level::onEnter puts the player next to a
+    // gate, so a gate can't be on it), one spawn and a gate
+    for (int x = 0; x < w; x++) {
+        if (terrain[x] != _TileType::SOLID ||
+        terrain[(hh - 1) * w + x] != _TileType::SOLID){
+            throw LevelPack::FormatException();
+        }
+    }
+    for (int y = 0; y < hh; y++) {
+        if (terrain[y * w] != _TileType::SOLID ||
+        terrain[y * w + w - 1] != _TileType::SOLID){
+            throw LevelPack::FormatException();
+        }
+    }
+
+    int spawns = 0, gates = 0;
+    for (int c = 0; c < w * hh; c++) {
+        // walls and floor are most of the level
+        const _TileType t = (_TileType)terrain[c];
+        if (t <= _TileType::DESTRUCTIBLE){
+            continue;
+        }
+        if (t == _TileType::SPAWN) {
+            spawns++;
+        } else if (MapAnalyzer::isGate(t)) {
+            gates++;
+        }
+    }
+    if (spawns != 1 || gates == 0){
+        throw LevelPack::FormatException();
+    }
+
+    // what Level builds without asking: an enemy, inside the level,
+    // that doesn't start in a wall, and a patroller that doesn't
+    // walk into one
+    const LevelPack::Spawn* s = (const LevelPack::Spawn*)
+    (this->base + e.spawnOffset);
+    for (std::uint32_t i = 0; i < e.spawnCount; i++) {
+        const _TileType type = (_TileType)s[i].type;
+        if (!MapAnalyzer::isEnemy(type) ||
+        s[i].sx >= w || s[i].sy >= hh || s[i].ex >= w || s[i].ey >= hh) {
+            throw LevelPack::FormatException();
+        }
+
+        if (MapAnalyzer::isWall((_TileType)terrain[s[i].sy * w + s[i].sx])){
+            throw LevelPack::FormatException();
+        }
+        if (type == _TileType::PATROLLER &&
+        MapAnalyzer::isWall((_TileType)terrain[s[i].ey * w + s[i].ex])) {
+            throw LevelPack::FormatException();
+        }
+    }
+}
+
+void LevelPack::close() {
+    if (this->base == nullptr){
+        return;
+    }
+
+    munmap((void*)this->base, this->length);
+    this->base = nullptr;
+    this->length = 0;
+    this->header = nullptr;
+    this->index = nullptr;
+}
+
+bool LevelPack::isOpen() const {
+    return this->base != nullptr;
+}
+
+unsigned int LevelPack::size() const {
+    if (this->header == nullptr){
+        return 0;
+    }
+    return this->header->levelCount;
+}
+
+unsigned short LevelPack::width() const {
+    if (this->header == nullptr){
+        return 0;
+    }
+    return this->header->width;
+}
+
+unsigned short LevelPack::height() const {
+    if (this->header == nullptr){
+        return 0;
+    }
+    return this->header->height;
+}
+
+LevelPack::Entry LevelPack::at(unsigned int i) const {
+    if (i >= this->size()){
+        throw LevelPack::IndexException();
+    }
+
+    const LevelPack::IndexEntry& e = this->index[i];
+
+    LevelPack::Entry out;
+    out.terrain = this->base + e.terrainOffset;
+    out.spawns = (const LevelPack::Spawn*)(this->base + e.spawnOffset);
+    out.spawnCount = e.spawnCount;
+    out.width = this->header->width;
+    out.height = this->header->height;
+    out.name = e.name;
+    return out;
+}
+
+// SECTION WRITER
+
+static std::uint32_t alignUp(std::uint32_t v) {
+    return (v + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+}
+
+/**
+ * @brief writes zeros until the file position is aligned
+ */
+static bool pad(FILE* f, std::uint32_t& pos) {
+    static const unsigned char zeros[PACK_ALIGN] = {0};
+    std::uint32_t next = alignUp(pos);
+    if (next == pos){
+        return true;
+    }
+    if (fwrite(zeros, 1, next - pos, f) != next - pos){
+        return false;
+    }
+    pos = next;
+    return true;
+}
+
+static unsigned int countEnemies(const Map& map) {
+    unsigned int n = 0;
+    for (unsigned short y = 0; y < map.height(); y++) {
+        for (unsigned short x = 0; x < map.width(); x++) {
+            if (MapAnalyzer::isEnemy(map.at(x, y).getType())){
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief writes the spawn table and the terrain of a map
+ */
+static bool writeLevel(FILE* f, const Map& map, std::uint32_t& pos) {
+    for (unsigned short y = 0; y < map.height(); y++) {
+        for (unsigned short x = 0; x < map.width(); x++) {
+            const _Tile& t = map.at(x, y);
+            if (!MapAnalyzer::isEnemy(t.getType())){
+                continue;
+            }
+
+            LevelPack::Spawn s;
+            s.type = (std::uint8_t)t.getType();
+            s.reserved = 0;
+            s.sx = t.getStartX();
+            s.sy = t.getStartY();
+            s.ex = t.getEndX();
+            s.ey = t.getEndY();
+            s.speed = t.getSpeed();
+            if (fwrite(&s, sizeof(s), 1, f) != 1){
+                return false;
+            }
+            pos += sizeof(s);
+        }
+    }
+
+    unsigned char row[MAP_WIDTH];
+    for (unsigned short y = 0; y < map.height(); y++) {
+        for (unsigned short x = 0; x < map.width(); x++) {
+            _TileType t = map.at(x, y).getType();
+            row[x] = (unsigned char)(MapAnalyzer::isEnemy(t) ?
+            _TileType::EMPTY : t);
+        }
+        if (fwrite(row, 1, map.width(), f) != map.width()){
+            return false;
+        }
+        pos += map.width();
+    }
+
+    return pad(f, pos);
+}
+
+void LevelPack::write(const char* path, const Map* const* maps,
+const char* const* names, unsigned int count) {
+    const std::uint64_t cells = (std::uint64_t)MAP_WIDTH * MAP_HEIGHT;
+
+    LevelPack::Header h;
+    memcpy(h.magic, PACK_MAGIC, 4);
+    h.version = LevelPack::VERSION;
+    h.width = MAP_WIDTH;
+    h.height = MAP_HEIGHT;
+    h.reserved = 0;
+    h.levelCount = count;
+    h.indexOffset = alignUp(sizeof(LevelPack::Header));
+
+    // offsets are known before writing, the file is written once
+    LevelPack::IndexEntry* entries = new LevelPack::IndexEntry[count];
+    std::uint64_t pos = alignUp(h.indexOffset +
+    count * (std::uint32_t)sizeof(LevelPack::IndexEntry));
+
+    for (unsigned int i = 0; i < count; i++) {
+        LevelPack::IndexEntry& e = entries[i];
+        memset(&e, 0, sizeof(e));
+
+        e.spawnCount = countEnemies(*maps[i]);
+        e.spawnOffset = (std::uint32_t)pos;
+        pos += (std::uint64_t)e.spawnCount * sizeof(LevelPack::Spawn);
+        e.terrainOffset = (std::uint32_t)pos;
+        pos = (pos + cells + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+
+        if (names != nullptr && names[i] != nullptr) {
+            for (int c = 0; c < LevelPack::NAME_SIZE - 1 &&
+            names[i][c] != '\0'; c++) {
+                e.name[c] = names[i][c];
+            }
+        }
+    }
+
+    if (pos > 0xFFFFFFFFULL) {
+        delete[] entries;
+        throw LevelPack::WriteException();
+    }
+    h.fileSize = (std::uint32_t)pos;
+
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        delete[] entries;
+        throw LevelPack::WriteException();
+    }
+
+    std::uint32_t written = 0;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    written += sizeof(h);
+    ok = ok && pad(f, written);
+
+    ok = ok && (count == 0 ||
+    fwrite(entries, sizeof(LevelPack::IndexEntry), count, f) == count);
+    written += count * (std::uint32_t)sizeof(LevelPack::IndexEntry);
+    ok = ok && pad(f, written);
+
+    for (unsigned int i = 0; ok && i < count; i++) {
+        ok = writeLevel(f, *maps[i], written);
+    }
+
+    delete[] entries;
+
+    if (fclose(f) != 0 || !ok || written != h.fileSize) {
+        remove(path);
+        throw LevelPack::WriteException();
+    }
+}
+
+//!SECTION
@@ -0,0 +1,234 @@
+/**
+ * @file levelpack.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief binary level pack, read through mmap
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the LevelPack class, a versioned binary file
+ * holding many levels ready to be loaded without parsing
+ *
+ * layout (native byte order, every offset from the file start):
+ *
+ * - Header at offset 0
+ *
+ * - an IndexEntry for each level, at indexOffset
+ *
+ * - for each level a spawn table (Spawn records, enemies in row
+ * major order) and a terrain array (width * height bytes, one
+ * _TileType per cell, row major, enemies stored as EMPTY)
+ *
+ * open() maps the file and checks the header, the index and what
+ * Level trusts in each level (one SPAWN tile, a gate, a SOLID border
+ * without gates, enemies inside the level and not in a wall, the
+ * MapAnalyzer rules), at() returns pointers into the mapping that
+ * Level reads directly
+ *
+ */
+
+#ifndef LEVELPACK_HPP
+#define LEVELPACK_HPP
+
+#include "maps.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+/**
+ * @brief a read-only, memory mapped pack of levels
+ */
+class LevelPack {
+public:
+    /**
+     * @brief format version written by write() and read by open()
+     */
+    static const unsigned int VERSION = 1;
+
+    /**
+     * @brief size of a level name, terminator included
+     */
+    static const int NAME_SIZE = 16;
+
+    /**
+     * @brief thrown when the pack file can't be opened or mapped
+     */
+    class OpenException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "cannot open the level pack";
+            }
+    };
+
+    /**
+     * @brief thrown when the file is not a level pack, has another
+     * version, points outside itself or holds a level the game
+     * can't build
+     */
+    class FormatException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "the file is not a valid level pack";
+            }
+    };
+
+    /**
+     * @brief thrown by at() with an index out of range
+     */
+    class IndexException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "level pack index out of range";
+            }
+    };
+
+    /**
+     * @brief thrown when write() can't create the pack
+     */
+    class WriteException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "cannot write the level pack";
+            }
+    };
+
+    /**
+     * @brief file header
+     */
+    struct Header {
+        char magic[4]; // "BGLP"
+        std::uint16_t version;
+        std::uint16_t width;
+        std::uint16_t height;
+        std::uint16_t reserved;
+        std::uint32_t levelCount;
+        std::uint32_t indexOffset;
+        std::uint32_t fileSize;
+    };
+
+    /**
+     * @brief where a level lives in the file
+     */
+    struct IndexEntry {
+        std::uint32_t terrainOffset;
+        std::uint32_t spawnOffset;
+        std::uint32_t spawnCount;
+        char name[LevelPack::NAME_SIZE];
+    };
+
+    /**
+     * @brief an enemy of a level, same fields as its map tile
+     */
+    struct Spawn {
+        std::uint8_t type; // a _TileType enemy value
+        std::uint8_t reserved;
+        std::uint16_t sx, sy;
+        std::uint16_t ex, ey;
+        std::uint16_t speed;
+    };
+
+    /**
+     * @brief a level of an open pack, valid until close()
+     */
+    struct Entry {
+        const std::uint8_t* terrain;
+        const LevelPack::Spawn* spawns;
+        unsigned int spawnCount;
+        unsigned short width, height;
+        const char* name;
+    };
+
+private:
+    const unsigned char* base;
+    std::size_t length;
+
+    const LevelPack::Header* header;
+    const LevelPack::IndexEntry* index;
+
+    /**
+     * @brief checks the header and the index of the mapping
+     *
+     * @throws FormatException on the first problem found
+     */
+    void validate() const;
+
+    /**
+     * @brief checks the terrain and the spawn table of a level
+     * whose offsets validate() already checked
+     *
+     * @throws FormatException if Level couldn't build it
+     */
+    void validateLevel(const LevelPack::IndexEntry& e) const;
+
+public:
+    LevelPack();
+
+    /**
+     * @brief unmaps the pack if it is open
+     */
+    ~LevelPack();
+
+    // entries point into the mapping, a copy would share it
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    /**
+     * @brief maps a pack file read-only
+     *
+     * the terrain and the spawn table of every level are scanned
+     * once, a few hundred bytes per level
+     *
+     * @throws OpenException if the file can't be opened or mapped
+     * @throws FormatException if the file is not a valid pack
+     */
+    void open(const char* path);
+
+    /**
+     * @brief unmaps the file, every Entry becomes invalid
+     */
+    void close();
+
+    /**
+     * @brief returns true between open() and close()
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief returns the number of levels
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief returns the width of every level
+     */
+    unsigned short width() const;
+
+    /**
+     * @brief returns the height of every level
+     */
+    unsigned short height() const;
+
+    /**
+     * @brief returns the level at index i
+     *
+     * @throws IndexException if i >= size()
+     */
+    LevelPack::Entry at(unsigned int i) const;
+
+    /**
+     * @brief converts maps into a pack file
+     *
+     * @param path output file, replaced if it exists
+     * @param maps maps to store, in order
+     * @param names level names (truncated to NAME_SIZE - 1),
+     * can be null
+     * @param count number of maps
+     * @throws WriteException if the file can't be written
+     */
+    static void write(const char* path, const Map* const* maps,
+    const char* const* names, unsigned int count);
+};
+
+#endif
@@ -37,8 +37,39 @@ class list {
             }
         };
 
-        list<T>::_node* head;
-        unsigned int size;
+        list<T>::_node* head = nullptr;
+        unsigned int size = 0;
+
+        // nodes released by remove/pop/clear, reused by the
+        // next insert so a list that stays around the same
+        // length stops touching the heap
+        list<T>::_node* spare = nullptr;
+        unsigned int spareCount = 0;
+
+        /**
+         * @brief returns a node holding value, taken from the spare
+         * nodes when possible, allocated otherwise
+         */
+        list<T>::_node* acquire(T value, list<T>::_node* next = nullptr) {
+            list<T>::_node* n = this->spare;
+            if (n == nullptr) {
+                return new list<T>::_node(value, next);
+            }
+            this->spare = n->next;
+            this->spareCount--;
+            n->payload = value;
+            n->next = next;
+            return n;
+        }
+
+        /**
+         * @brief gives a node back to the spare nodes
+         */
+        void recycle(list<T>::_node* n) {
+            n->next = this->spare;
+            this->spare = n;
+            this->spareCount++;
+        }
 
     public:
         class EmptyListException : public std::exception {
@@ -96,9 +127,7 @@ class list {
         list() : head(nullptr), size(0) { }
 
         list(T element){
-            this->head = new list<T>::_node;
-            head->payload = element;
-            head->next = nullptr;
+            this->head = new list<T>::_node(element);
             this->size = 1;
         }
 
@@ -122,25 +151,48 @@ class list {
         }
 
         ~list(){
-            list<T>::_node* current = this->head;
-            while (current != nullptr) {
-                list<T>::_node* next = current->next;
-                delete current;
-                current = next;
+            this->clear();
+            this->shrink();
+        }
+
+        /**
+         * @brief makes sure n elements fit without allocating
+         *
+         * missing nodes are allocated now and kept as spare nodes
+         */
+        void reserve(unsigned int n) {
+            while (this->size + this->spareCount < n) {
+                this->recycle(new list<T>::_node);
             }
-            this->head = nullptr;
-            this->size = 0;
+        }
+
+        /**
+         * @brief frees every spare node
+         */
+        void shrink() {
+            while (this->spare != nullptr) {
+                list<T>::_node* next = this->spare->next;
+                delete this->spare;
+                this->spare = next;
+            }
+            this->spareCount = 0;
+        }
+
+        /**
+         * @brief returns how many elements fit without allocating
+         */
+        unsigned int capacity() const {
+            return this->size + this->spareCount;
         }
 
         void push_front(T value) {
-            list<T>::_node* n = new list<T>::_node{value, head};
-            this->head = n;
+            this->head = this->acquire(value, this->head);
             this->size++;
         }
 
         void push_back(T element){
             if(head == nullptr){
-                this->head = new list<T>::_node(element);
+                this->head = this->acquire(element);
                 this->size = 1;
                 return;
             }
@@ -150,7 +202,7 @@ class list {
                 iterator = iterator->next;
             }
 
-            iterator->next = new _node(element);
+            iterator->next = this->acquire(element);
             this->size++;
         }
 
@@ -161,7 +213,7 @@ class list {
                     
             if (this->head->next == nullptr) {
                 T value = head->payload;
-                delete this->head;
+                this->recycle(this->head);
                 this->head = nullptr;
                 this->size = 0;
                 return value;
@@ -177,7 +229,7 @@ class list {
 
             T value = current->payload;
 
-            delete current;
+            this->recycle(current);
             prev->next = nullptr;
 
             this->size--;
@@ -194,7 +246,8 @@ class list {
             if(this->head->next == nullptr){
                 T value = this->head->payload;
 
-                delete head;
+                this->recycle(this->head);
+                this->head = nullptr;
                 this->size = 0;
 
                 return value;
@@ -204,7 +257,7 @@ class list {
 
             T value = this->head->payload;
 
-            delete this->head;
+            this->recycle(this->head);
 
             this->head = ptr;
 
@@ -255,7 +308,7 @@ class list {
                 tmp = tmp->next;
             }
 
-            list<T>::_node* new_node = new list<T>::_node(element, tmp->next);
+            list<T>::_node* new_node = this->acquire(element, tmp->next);
             tmp->next = new_node;
 
             this->size++;
@@ -299,7 +352,7 @@ class list {
             if (index == 0) {
                 removed_value = tmp->payload;
                 this->head = tmp->next;
-                delete tmp;
+                this->recycle(tmp);
             } else {
                 list<T>::_node* prev = nullptr;
                 for (unsigned int i = 0; i < index; i++) {
@@ -309,7 +362,7 @@ class list {
 
                 removed_value = tmp->payload;
                 prev->next = tmp->next;
-                delete tmp;
+                this->recycle(tmp);
             }
 
             this->size--;
@@ -372,12 +425,18 @@ class list {
             this->head = prev;  
         }
 
+        /**
+         * @brief removes every element
+         *
+         * the nodes are kept as spare nodes, call shrink()
+         * to give the memory back
+         */
         void clear() {
             list<T>::_node* current = this->head;
                     
             while (current != nullptr) {
                 list<T>::_node* next = current->next;
-                delete current;
+                this->recycle(current);
                 current = next;
             }
                     
@@ -391,9 +450,9 @@ class list {
 
         template <typename Predicate>
         void remove_if(Predicate pred) {
-            for(int i = 0; i < this->len(); ) {
+            for(unsigned int i = 0; i < this->len(); ) {
                 if(pred(this->at(i))) {
-                    this->remove_at(i);
+                    this->remove(i);
                 } else {
                     i++;
                 }
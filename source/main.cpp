@@ -21,29 +21,119 @@
 #include "game.hpp"
 #include "leaderboard.hpp"
 #include "level.hpp"
+#include "levelpack.hpp"
 #include "maps.hpp"
 #include "menu.hpp"
 #include "name_entry.hpp"
 #include "player.hpp"
 #include "powerup.hpp"
+#include "profiler.hpp"
 #include "random.hpp"
+#include "recorder.hpp"
 #include "render.hpp"
 
 #include "list.hpp"
 
+#include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <ncurses.h>
 
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [--ansi] [--fast-start] [--stats] "
+    "[--record FILE] [--levels PACK] [--watch]\n", prog);
+    fprintf(stderr, "  --ansi   draw the screens with raw escape "
+    "sequences instead of ncurses\n");
+    fprintf(stderr, "  --fast-start  skip the color test and the "
+    "startup delays\n");
+    fprintf(stderr, "  --stats  print the render counters on exit\n");
+    fprintf(stderr, "  --record FILE  save the session as an asciicast "
+    "v2 file\n");
+    fprintf(stderr, "  --levels PACK  play the first %d levels of a "
+    "level pack\n", MAX_LEVEL_SIZE);
+    fprintf(stderr, "  --watch  reload bonus.csv in bonus mode when it "
+    "is saved\n");
+}
+
+static void printStats() {
+    fprintf(stderr, "startup_ms: %.2f\n", (double)Render::startupNs() / 1e6);
+    for (int c = 0; c < Profiler::COUNTER_COUNT; c++) {
+        fprintf(stderr, "%s: %llu\n",
+        Profiler::name((Profiler::Counter)c),
+        Profiler::counter((Profiler::Counter)c));
+    }
+}
+
+int main(int argc, char** argv) {
+    bool stats = false;
+    const char* recordPath = nullptr;
+    const char* packPath = nullptr;
+    bool watch = false;
 
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ansi") == 0) {
+            Render::setBackend(Render::Backend::ANSI);
+        } else if (strcmp(argv[i], "--fast-start") == 0) {
+            Render::setFastStart(true);
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            packPath = argv[++i];
+        } else if (strcmp(argv[i], "--watch") == 0) {
+            watch = true;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Profiler::enable(stats);
+
+    // checked before the screen is taken over
+    LevelPack pack;
+    if (packPath != nullptr) {
+        try {
+            pack.open(packPath);
+        } catch (const std::exception& e) {
+            fprintf(stderr, "%s: %s\n", packPath, e.what());
+            return 1;
+        }
+        if (pack.size() < MAX_LEVEL_SIZE || pack.width() != MAP_WIDTH ||
+        pack.height() != MAP_HEIGHT) {
+            fprintf(stderr, "%s: need %d levels of %dx%d\n", packPath,
+            MAX_LEVEL_SIZE, MAP_WIDTH, MAP_HEIGHT);
+            return 1;
+        }
+    }
 
-int main() {
     Render::init();
 
-    Game game;
+    Recorder recorder;
+    if (recordPath != nullptr) {
+        try {
+            recorder.open(recordPath, COLS, LINES);
+        } catch (const Recorder::OpenException& e) {
+            Render::shutdown();
+            fprintf(stderr, "%s: %s\n", recordPath, e.what());
+            return 1;
+        }
+        Render::setRecorder(&recorder);
+    }
+
+    Game game(pack.isOpen() ? &pack : nullptr);
+    game.setHotReload(watch);
     game.run();
 
+    Render::setRecorder(nullptr);
     Render::shutdown();
+    recorder.close();
+
+    if (stats){
+        printStats();
+    }
 
     return 0;
 }
@@ -0,0 +1,460 @@
+/**
+ * @file map_analyzer.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief map_analyzer.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "map_analyzer.hpp"
+
+static const int MAP_CELLS = MAP_WIDTH * MAP_HEIGHT;
+
+static const unsigned short UNSEEN = 0xFFFF;
+
+static const int DX[4] = {1, -1, 0, 0};
+static const int DY[4] = {0, 0, 1, -1};
+
+static bool onBorder(unsigned short x, unsigned short y) {
+    return x == 0 || y == 0 || x == MAP_WIDTH - 1 || y == MAP_HEIGHT - 1;
+}
+
+static bool inside(int x, int y) {
+    return x >= 0 && y >= 0 && x < MAP_WIDTH && y < MAP_HEIGHT;
+}
+
+/**
+ * @brief returns the distance in steps from (sx,sy) of every cell,
+ * UNSEEN if unreachable
+ *
+ * @param throughWalls if true destructible walls are crossed too
+ * (the player bombs them), SOLID cells never are
+ */
+static void stepDistances(const Map& map, unsigned short sx,
+unsigned short sy, bool throughWalls, unsigned short* dist) {
+    unsigned short queue[MAP_CELLS];
+    int head = 0, tail = 0;
+
+    for (int i = 0; i < MAP_CELLS; i++) {
+        dist[i] = UNSEEN;
+    }
+
+    dist[sy * MAP_WIDTH + sx] = 0;
+    queue[tail++] = (unsigned short)(sy * MAP_WIDTH + sx);
+
+    while (head < tail) {
+        const unsigned short c = queue[head++];
+        const int x = c % MAP_WIDTH;
+        const int y = c / MAP_WIDTH;
+
+        for (int d = 0; d < 4; d++) {
+            const int tx = x + DX[d];
+            const int ty = y + DY[d];
+            if (!inside(tx, ty)){
+                continue;
+            }
+
+            const int n = ty * MAP_WIDTH + tx;
+            if (dist[n] != UNSEEN){
+                continue;
+            }
+
+            const _TileType t = map.at(tx, ty).getType();
+            if (t == _TileType::SOLID ||
+            (t == _TileType::DESTRUCTIBLE && !throughWalls)) {
+                continue;
+            }
+
+            dist[n] = (unsigned short)(dist[c] + 1);
+            queue[tail++] = (unsigned short)n;
+        }
+    }
+}
+
+/**
+ * @brief returns the fewest destructible walls between (sx,sy) and
+ * every cell, UNSEEN if a SOLID wall is always in the way
+ *
+ * 0-1 BFS on a circular deque: free cells are pushed at the front
+ */
+static void wallCosts(const Map& map, unsigned short sx,
+unsigned short sy, unsigned short* cost) {
+    static const int QUEUE = 2 * MAP_CELLS;
+    unsigned short queue[QUEUE];
+    int head = MAP_CELLS, tail = MAP_CELLS;
+
+    for (int i = 0; i < MAP_CELLS; i++) {
+        cost[i] = UNSEEN;
+    }
+
+    cost[sy * MAP_WIDTH + sx] = 0;
+    queue[tail++] = (unsigned short)(sy * MAP_WIDTH + sx);
+
+    while (head != tail) {
+        const unsigned short c = queue[head];
+        head = (head + 1) % QUEUE;
+        const int x = c % MAP_WIDTH;
+        const int y = c / MAP_WIDTH;
+
+        for (int d = 0; d < 4; d++) {
+            const int tx = x + DX[d];
+            const int ty = y + DY[d];
+            if (!inside(tx, ty)){
+                continue;
+            }
+
+            const _TileType t = map.at(tx, ty).getType();
+            if (t == _TileType::SOLID){
+                continue;
+            }
+
+            const int n = ty * MAP_WIDTH + tx;
+            const int step = t == _TileType::DESTRUCTIBLE ? 1 : 0;
+            if (cost[n] != UNSEEN && cost[n] <= cost[c] + step){
+                continue;
+            }
+
+            cost[n] = (unsigned short)(cost[c] + step);
+            if (step == 0) {
+                head = (head + QUEUE - 1) % QUEUE;
+                queue[head] = (unsigned short)n;
+            } else {
+                queue[tail] = (unsigned short)n;
+                tail = (tail + 1) % QUEUE;
+            }
+        }
+    }
+}
+
+bool MapAnalyzer::isEnemy(_TileType t) {
+    return t == _TileType::WALKER || t == _TileType::PATROLLER ||
+    t == _TileType::CHASER;
+}
+
+bool MapAnalyzer::isGate(_TileType t) {
+    return t == _TileType::GATE_NEXT || t == _TileType::GATE_PREV;
+}
+
+bool MapAnalyzer::isWall(_TileType t) {
+    return t == _TileType::SOLID || t == _TileType::DESTRUCTIBLE;
+}
+
+void MapAnalyzer::add(MapAnalyzer::Report& r, MapAnalyzer::Severity s,
+unsigned short x, unsigned short y, const char* message) {
+    if (s == MapAnalyzer::Severity::ERROR) {
+        r.errors++;
+    } else {
+        r.warnings++;
+    }
+
+    if (r.findingCount >= MapAnalyzer::MAX_FINDINGS){
+        return;
+    }
+
+    MapAnalyzer::Finding& f = r.findings[r.findingCount++];
+    f.severity = s;
+    f.x = x;
+    f.y = y;
+    f.message = message;
+}
+
+bool MapAnalyzer::playable(const MapAnalyzer::Report& r) {
+    return r.errors == 0;
+}
+
+void MapAnalyzer::analyze(const Map& map, MapAnalyzer::Report& out) {
+    out.findingCount = 0;
+    out.errors = 0;
+    out.warnings = 0;
+    out.open = out.solid = out.destructible = 0;
+    out.walkers = out.patrollers = out.chasers = 0;
+    out.reachableWalking = out.reachableBombing = 0;
+    out.gateSteps = out.gateWalls = -1;
+    out.nearestEnemy = -1;
+    out.threat = 0.0;
+    out.difficulty = 0.0;
+
+    MapAnalyzer::checkTiles(map, out);
+    MapAnalyzer::checkEnemies(map, out);
+    MapAnalyzer::checkReachability(map, out);
+
+    // a rough mix: enemies count the most, then the walls to bomb
+    // and the way to walk to the exit, an enemy close to the spawn
+    // leaves no time to react
+    out.difficulty = out.threat * 10.0;
+    if (out.gateSteps >= 0) {
+        out.difficulty += out.gateWalls * 2.0 + out.gateSteps / 4.0;
+    }
+    if (out.nearestEnemy >= 0) {
+        out.difficulty += 20.0 / (1 + out.nearestEnemy);
+    }
+}
+
+// SECTION TILES
+
+void MapAnalyzer::checkTiles(const Map& map, MapAnalyzer::Report& r) {
+    int spawns = 0, gates = 0;
+    bool openBorder = false;
+
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            const _TileType t = map.at(x, y).getType();
+
+            if (t == _TileType::SOLID) {
+                r.solid++;
+            } else if (t == _TileType::DESTRUCTIBLE) {
+                r.destructible++;
+            } else {
+                r.open++;
+            }
+
+            // one finding is enough for the whole border
+            if (onBorder(x, y) && t != _TileType::SOLID && !openBorder) {
+                openBorder = true;
+                MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                "the border is not SOLID, the player can walk off the "
+                "board");
+            }
+
+            if (t == _TileType::SPAWN) {
+                spawns++;
+                if (spawns == 2) {
+                    MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                    "more than one SPAWN");
+                }
+            } else if (MapAnalyzer::isGate(t)) {
+                gates++;
+                if (onBorder(x, y)) {
+                    MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                    "gate on the border");
+                }
+            }
+        }
+    }
+
+    if (spawns == 0) {
+        MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, 0, 0,
+        "no SPAWN");
+    }
+    if (gates == 0) {
+        MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, 0, 0,
+        "no gate");
+    }
+}
+
+//!SECTION
+
+// SECTION ENEMIES
+
+/**
+ * @brief true if Board::isWalkable would return true for the cell
+ * once the map is loaded (spawn and enemy cells stay EMPTY)
+ */
+static bool walkableTerrain(const Map& map, int x, int y) {
+    return !MapAnalyzer::isWall(map.at(x, y).getType());
+}
+
+/**
+ * @brief true if Board::isWalkable returns true for (sx,sy) while
+ * Level::load builds the enemy of cell (x,y)
+ *
+ * cells are loaded in row major order, the later ones are
+ * still EMPTY (Board::clear)
+ */
+static bool walkableWhileLoading(const Map& map, int x, int y,
+int sx, int sy) {
+    if (sy * MAP_WIDTH + sx >= y * MAP_WIDTH + x){
+        return true;
+    }
+    return walkableTerrain(map, sx, sy);
+}
+
+/**
+ * @brief follows a patroller from its start as Patroller::update
+ * does on the loaded terrain
+ *
+ * @return true if it reaches its end, else bx,by is where it turns
+ */
+static bool patrolReachesEnd(const Map& map, const _Tile& t, int& bx,
+int& by) {
+    int x = t.getStartX(), y = t.getStartY();
+    const int ex = t.getEndX(), ey = t.getEndY();
+
+    // every step gets closer to the end
+    for (int i = 0; i <= MAP_WIDTH + MAP_HEIGHT; i++) {
+        if (x == ex && y == ey){
+            return true;
+        }
+
+        const int stepX = x < ex ? 1 : (x > ex ? -1 : 0);
+        const int stepY = y < ey ? 1 : (y > ey ? -1 : 0);
+
+        if (stepX != 0 && walkableTerrain(map, x + stepX, y)) {
+            x += stepX;
+        } else if (stepY != 0 && walkableTerrain(map, x, y + stepY)) {
+            y += stepY;
+        } else {
+            break;
+        }
+    }
+
+    bx = x;
+    by = y;
+    return false;
+}
+
+void MapAnalyzer::checkEnemies(const Map& map, MapAnalyzer::Report& r) {
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            const _Tile& t = map.at(x, y);
+            const _TileType type = t.getType();
+            if (!MapAnalyzer::isEnemy(type)){
+                continue;
+            }
+
+            // the threat grows with the moves per second
+            const double moves = 10.0 / (t.getSpeed() > 0 ?
+            t.getSpeed() : 1);
+            if (type == _TileType::WALKER) {
+                r.walkers++;
+                r.threat += moves;
+            } else if (type == _TileType::PATROLLER) {
+                r.patrollers++;
+                r.threat += moves;
+            } else {
+                r.chasers++;
+                r.threat += 3.0 * moves;
+            }
+
+            const int sx = t.getStartX(), sy = t.getStartY();
+
+            if (!inside(sx, sy)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                "enemy starts outside the map "
+                "(Board::BoardOutOfBoundsException)");
+                continue;
+            }
+
+            if (!walkableWhileLoading(map, x, y, sx, sy)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                "enemy starts on a wall "
+                "(Enemy::InvalidStartingPositionException)");
+                continue;
+            }
+
+            if (!walkableTerrain(map, sx, sy)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING, x, y,
+                "enemy starts on a wall loaded after it, it is stuck");
+                continue;
+            }
+
+            if (t.getSpeed() == 0) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING, x, y,
+                "enemy speed 0, it moves every tick");
+            }
+
+            if (type != _TileType::PATROLLER){
+                continue;
+            }
+
+            const int ex = t.getEndX(), ey = t.getEndY();
+            int bx = 0, by = 0;
+
+            if (!inside(ex, ey)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING, x, y,
+                "patroller ends outside the map");
+            } else if (!walkableTerrain(map, ex, ey)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING, x, y,
+                "patroller ends on a wall");
+            } else if (ex == sx && ey == sy) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING, x, y,
+                "patroller starts and ends on the same cell");
+            } else if (!patrolReachesEnd(map, t, bx, by)) {
+                MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING,
+                (unsigned short)bx, (unsigned short)by,
+                "patroller turns back before its end");
+            }
+        }
+    }
+}
+
+//!SECTION
+
+// SECTION REACHABILITY
+
+void MapAnalyzer::checkReachability(const Map& map,
+MapAnalyzer::Report& r) {
+    int sx = -1, sy = -1;
+    for (unsigned short y = 0; y < MAP_HEIGHT && sx < 0; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            if (map.at(x, y).getType() == _TileType::SPAWN) {
+                sx = x;
+                sy = y;
+                break;
+            }
+        }
+    }
+
+    // no spawn, already reported
+    if (sx < 0){
+        return;
+    }
+
+    unsigned short walking[MAP_CELLS];
+    unsigned short bombing[MAP_CELLS];
+    unsigned short walls[MAP_CELLS];
+
+    stepDistances(map, (unsigned short)sx, (unsigned short)sy, false,
+    walking);
+    stepDistances(map, (unsigned short)sx, (unsigned short)sy, true,
+    bombing);
+    wallCosts(map, (unsigned short)sx, (unsigned short)sy, walls);
+
+    for (int i = 0; i < MAP_CELLS; i++) {
+        if (walking[i] != UNSEEN){
+            r.reachableWalking++;
+        }
+        if (bombing[i] != UNSEEN){
+            r.reachableBombing++;
+        }
+    }
+
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            const _Tile& t = map.at(x, y);
+            const int c = y * MAP_WIDTH + x;
+
+            if (MapAnalyzer::isGate(t.getType())) {
+                if (walls[c] == UNSEEN) {
+                    MapAnalyzer::add(r, MapAnalyzer::Severity::ERROR, x, y,
+                    "gate can't be reached from the spawn");
+                } else if (t.getType() == _TileType::GATE_NEXT &&
+                (r.gateSteps < 0 || bombing[c] < r.gateSteps)) {
+                    r.gateSteps = bombing[c];
+                    r.gateWalls = walls[c];
+                }
+            }
+
+            if (MapAnalyzer::isEnemy(t.getType()) &&
+            inside(t.getStartX(), t.getStartY())) {
+                const unsigned short d =
+                bombing[t.getStartY() * MAP_WIDTH + t.getStartX()];
+                if (d != UNSEEN &&
+                (r.nearestEnemy < 0 || d < r.nearestEnemy)) {
+                    r.nearestEnemy = d;
+                }
+            }
+        }
+    }
+
+    if (r.nearestEnemy >= 0 && r.nearestEnemy <= 1) {
+        MapAnalyzer::add(r, MapAnalyzer::Severity::WARNING,
+        (unsigned short)sx, (unsigned short)sy,
+        "an enemy starts next to the spawn");
+    }
+}
+
+//!SECTION
@@ -0,0 +1,144 @@
+/**
+ * @file map_analyzer.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief static checks and difficulty statistics of a map
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the MapAnalyzer class, which inspects a Map
+ * without building a Level and reports every problem it finds
+ *
+ * the checks go further than Parser::loadBonusFile: the gates must
+ * be reachable from the spawn (walking, or bombing destructible
+ * walls), every enemy must be built without an exception, in the
+ * order Level::load builds them, and patrollers must reach their end
+ *
+ * it also estimates how hard the map is, so packs can be sorted
+ * and screened in bulk (see tools/validate.cpp)
+ *
+ * the tile rules (enemies, gates, walls) are public, LevelPack
+ * checks its levels with the same ones
+ *
+ */
+
+#ifndef MAP_ANALYZER_HPP
+#define MAP_ANALYZER_HPP
+
+#include "maps.hpp"
+
+/**
+ * @brief inspects maps, stateless
+ */
+class MapAnalyzer {
+public:
+    /**
+     * @brief how bad a finding is
+     *
+     * an ERROR map can't be played (an exception, an unreachable
+     * gate), a WARNING map can but is probably not what was meant
+     */
+    enum Severity {
+        WARNING,
+        ERROR
+    };
+
+    /**
+     * @brief a problem found at a map cell
+     */
+    struct Finding {
+        MapAnalyzer::Severity severity;
+        unsigned short x, y;
+        const char* message; // a static string
+    };
+
+    /**
+     * @brief findings kept by a Report, the others are only counted
+     */
+    static const int MAX_FINDINGS = 32;
+
+    /**
+     * @brief everything analyze() finds out about a map
+     */
+    struct Report {
+        MapAnalyzer::Finding findings[MapAnalyzer::MAX_FINDINGS];
+        int findingCount; // stored in findings
+        int errors;       // all of them, stored or not
+        int warnings;
+
+        // cells by kind, enemies are on EMPTY cells
+        int open, solid, destructible;
+        int walkers, patrollers, chasers;
+
+        // cells reachable from the spawn walking, and bombing walls
+        int reachableWalking, reachableBombing;
+
+        // shortest way from the spawn to GATE_NEXT (-1 if none):
+        // cells walked and destructible walls on the way
+        int gateSteps, gateWalls;
+
+        // steps from the spawn to the nearest enemy start (-1 if none)
+        int nearestEnemy;
+
+        // sum of the enemy threats, faster and smarter enemies
+        // weigh more (a chaser moving every 10 ticks weighs 3)
+        double threat;
+
+        // rough score to sort levels, higher is harder
+        double difficulty;
+    };
+
+private:
+    /**
+     * @brief adds a finding to the report
+     */
+    static void add(MapAnalyzer::Report& r, MapAnalyzer::Severity s,
+    unsigned short x, unsigned short y, const char* message);
+
+    /**
+     * @brief counts tiles and checks spawn and gates placement
+     */
+    static void checkTiles(const Map& map, MapAnalyzer::Report& r);
+
+    /**
+     * @brief checks every enemy as Level::load would build it
+     */
+    static void checkEnemies(const Map& map, MapAnalyzer::Report& r);
+
+    /**
+     * @brief checks reachability from the spawn and fills the
+     * distance statistics
+     */
+    static void checkReachability(const Map& map, MapAnalyzer::Report& r);
+
+public:
+    /**
+     * @brief true for WALKER, PATROLLER and CHASER
+     */
+    static bool isEnemy(_TileType t);
+
+    /**
+     * @brief true for GATE_NEXT and GATE_PREV
+     */
+    static bool isGate(_TileType t);
+
+    /**
+     * @brief true for the tiles nobody walks on (SOLID, DESTRUCTIBLE)
+     */
+    static bool isWall(_TileType t);
+
+    /**
+     * @brief analyzes a map, out is overwritten
+     *
+     * makes no heap allocation and can run on many threads at once
+     */
+    static void analyze(const Map& map, MapAnalyzer::Report& out);
+
+    /**
+     * @brief returns true if the report has no error
+     */
+    static bool playable(const MapAnalyzer::Report& r);
+};
+
+#endif
@@ -0,0 +1,362 @@
+/**
+ * @file map_generator.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief map_generator.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "map_generator.hpp"
+
+static const int MAP_CELLS = MAP_WIDTH * MAP_HEIGHT;
+
+// cells within this manhattan distance of the spawn stay free
+static const int SPAWN_CLEARANCE = 2;
+
+// GATE_NEXT is the farthest from the spawn of this many picks
+static const int GATE_PICKS = 8;
+
+// longest patroller path, in cells
+static const int PATROL_LENGTH = 4;
+
+static int clampInt(int v, int lo, int hi) {
+    if (v < lo){
+        return lo;
+    }
+    if (v > hi){
+        return hi;
+    }
+    return v;
+}
+
+static int distance(unsigned short ax, unsigned short ay,
+unsigned short bx, unsigned short by) {
+    int dx = (int)ax - (int)bx;
+    int dy = (int)ay - (int)by;
+    return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+}
+
+/**
+ * @brief returns an odd value in [1, limit - 2]
+ */
+static unsigned short randomOdd(Random& rng, unsigned short limit) {
+    return (unsigned short)(1 + 2 * rng.nextInt(0, (limit - 3) / 2));
+}
+
+MapGenerator::MapGenerator() : params() {}
+
+MapGenerator::MapGenerator(const MapGenerator::Params& params) :
+params(params) {
+    MapGenerator::Params& p = this->params;
+
+    p.width = (unsigned short)clampInt(p.width, 7, MAP_WIDTH);
+    p.height = (unsigned short)clampInt(p.height, 7, MAP_HEIGHT);
+    p.blockPercent = clampInt(p.blockPercent, 0, 50);
+    p.wallPercent = clampInt(p.wallPercent, 0, 100);
+    p.walkers = clampInt(p.walkers, 0, MAP_CELLS);
+    p.chasers = clampInt(p.chasers, 0, MAP_CELLS);
+    p.patrollers = clampInt(p.patrollers, 0, MAP_CELLS);
+    p.walkerSpeed = (unsigned short)clampInt(p.walkerSpeed, 1, 1000);
+    p.chaserSpeed = (unsigned short)clampInt(p.chaserSpeed, 1, 1000);
+    p.patrollerSpeed = (unsigned short)clampInt(p.patrollerSpeed, 1, 1000);
+}
+
+const MapGenerator::Params& MapGenerator::getParams() const {
+    return this->params;
+}
+
+bool MapGenerator::isPillar(unsigned short x, unsigned short y) const {
+    return this->params.pillars && x % 2 == 0 && y % 2 == 0;
+}
+
+bool MapGenerator::isInterior(unsigned short x, unsigned short y) const {
+    return x > 0 && y > 0 && x < this->params.width - 1 &&
+    y < this->params.height - 1;
+}
+
+Map MapGenerator::generate(unsigned long long seed) const {
+    Map m;
+    this->generate(seed, m);
+    return m;
+}
+
+void MapGenerator::generate(unsigned long long seed, Map& out) const {
+    // the raw seed is mixed, close seeds give unrelated maps and
+    // the seed 0 doesn't stall the generator
+    unsigned long long state = Random::mix64(seed);
+    if (state == 0ULL){
+        state = 0xD1B54A32D192ED03ULL;
+    }
+    Random rng(state);
+
+    this->placeTerrain(out, rng);
+
+    unsigned short sx = 0, sy = 0;
+    this->placeSpawn(out, rng, sx, sy);
+
+    unsigned short cells[MAP_CELLS];
+    int count = this->collectCells(sx, sy, cells);
+
+    unsigned short nextCell = this->pickGate(rng, cells, count, sx, sy,
+    true);
+    unsigned short prevCell = this->pickGate(rng, cells, count, sx, sy,
+    false);
+
+    const unsigned short nx = nextCell % MAP_WIDTH;
+    const unsigned short ny = nextCell / MAP_WIDTH;
+    const unsigned short px = prevCell % MAP_WIDTH;
+    const unsigned short py = prevCell / MAP_WIDTH;
+
+    out.placeTile(nx, ny, _Tile(_TileType::GATE_NEXT, nx, ny));
+    out.placeTile(px, py, _Tile(_TileType::GATE_PREV, px, py));
+
+    this->connect(out, sx, sy, nx, ny, px, py);
+
+    this->placeEnemies(out, rng, cells, count);
+}
+
+// SECTION TERRAIN
+
+void MapGenerator::placeTerrain(Map& m, Random& rng) const {
+    const MapGenerator::Params& p = this->params;
+
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            _TileType t = _TileType::EMPTY;
+
+            // every random value is drawn, whatever the cell
+            // becomes, so the walls don't depend on the blocks
+            const int block = rng.nextInt(0, 99);
+            const int wall = rng.nextInt(0, 99);
+
+            if (!this->isInterior(x, y) || this->isPillar(x, y)) {
+                t = _TileType::SOLID;
+            } else if (block < p.blockPercent) {
+                t = _TileType::SOLID;
+            } else if (wall < p.wallPercent) {
+                t = _TileType::DESTRUCTIBLE;
+            }
+
+            m.set(x, y, _Tile(t, x, y));
+        }
+    }
+}
+
+void MapGenerator::placeSpawn(Map& m, Random& rng, unsigned short& sx,
+unsigned short& sy) const {
+    // odd coordinates are never a pillar
+    sx = randomOdd(rng, this->params.width);
+    sy = randomOdd(rng, this->params.height);
+
+    for (int dy = -SPAWN_CLEARANCE; dy <= SPAWN_CLEARANCE; dy++) {
+        for (int dx = -SPAWN_CLEARANCE; dx <= SPAWN_CLEARANCE; dx++) {
+            const unsigned short x = (unsigned short)(sx + dx);
+            const unsigned short y = (unsigned short)(sy + dy);
+
+            if (distance(x, y, sx, sy) > SPAWN_CLEARANCE ||
+            !this->isInterior(x, y) || this->isPillar(x, y)) {
+                continue;
+            }
+            m.set(x, y, _Tile(_TileType::EMPTY, x, y));
+        }
+    }
+
+    m.setSpawn(sx, sy);
+}
+
+int MapGenerator::collectCells(unsigned short sx, unsigned short sy,
+unsigned short* cells) const {
+    int count = 0;
+    for (unsigned short y = 1; y < this->params.height - 1; y++) {
+        for (unsigned short x = 1; x < this->params.width - 1; x++) {
+            if (this->isPillar(x, y) ||
+            distance(x, y, sx, sy) <= SPAWN_CLEARANCE) {
+                continue;
+            }
+            cells[count++] = (unsigned short)(y * MAP_WIDTH + x);
+        }
+    }
+    return count;
+}
+
+//!SECTION
+
+// SECTION GATES
+
+unsigned short MapGenerator::pickGate(Random& rng, unsigned short* cells,
+int& count, unsigned short sx, unsigned short sy, bool far) const {
+    // a 7x7 area always leaves a few cells out of the spawn area
+    int best = rng.nextInt(0, count - 1);
+
+    if (far) {
+        int bestDistance = -1;
+        for (int i = 0; i < GATE_PICKS; i++) {
+            int pick = rng.nextInt(0, count - 1);
+            int d = distance(cells[pick] % MAP_WIDTH,
+            cells[pick] / MAP_WIDTH, sx, sy);
+            if (d > bestDistance) {
+                bestDistance = d;
+                best = pick;
+            }
+        }
+    }
+
+    // the chosen cell leaves the candidates
+    unsigned short cell = cells[best];
+    cells[best] = cells[--count];
+    return cell;
+}
+
+void MapGenerator::connect(Map& m, unsigned short sx, unsigned short sy,
+unsigned short nx, unsigned short ny, unsigned short px,
+unsigned short py) const {
+    // 0-1 BFS from the spawn: entering a SOLID cell costs 1, any
+    // other cell 0, so every cell gets the fewest SOLID cells on a
+    // path from the spawn
+    static const unsigned short UNSEEN = 0xFFFF;
+    static const int QUEUE = 2 * MAP_CELLS;
+
+    unsigned short cost[MAP_CELLS];
+    unsigned short from[MAP_CELLS];
+    unsigned short queue[QUEUE];
+
+    for (int i = 0; i < MAP_CELLS; i++) {
+        cost[i] = UNSEEN;
+        from[i] = UNSEEN;
+    }
+
+    // a circular deque: cost 0 moves are pushed at the front
+    int head = MAP_CELLS, tail = MAP_CELLS;
+    const unsigned short start = (unsigned short)(sy * MAP_WIDTH + sx);
+    cost[start] = 0;
+    queue[tail++] = start;
+
+    static const int DX[4] = {1, -1, 0, 0};
+    static const int DY[4] = {0, 0, 1, -1};
+
+    while (head != tail) {
+        const unsigned short c = queue[head];
+        head = (head + 1) % QUEUE;
+
+        const unsigned short x = c % MAP_WIDTH;
+        const unsigned short y = c / MAP_WIDTH;
+
+        for (int d = 0; d < 4; d++) {
+            const unsigned short tx = (unsigned short)(x + DX[d]);
+            const unsigned short ty = (unsigned short)(y + DY[d]);
+            if (!this->isInterior(tx, ty)){
+                continue;
+            }
+
+            const unsigned short n = (unsigned short)(ty * MAP_WIDTH + tx);
+            const int step =
+            m.at(tx, ty).getType() == _TileType::SOLID ? 1 : 0;
+            if (cost[n] != UNSEEN && cost[n] <= cost[c] + step){
+                continue;
+            }
+
+            cost[n] = (unsigned short)(cost[c] + step);
+            from[n] = c;
+            if (step == 0) {
+                head = (head + QUEUE - 1) % QUEUE;
+                queue[head] = n;
+            } else {
+                queue[tail] = n;
+                tail = (tail + 1) % QUEUE;
+            }
+        }
+    }
+
+    // walls on the way back from each gate become destructible,
+    // the player bombs through them
+    const unsigned short gates[2] = {
+        (unsigned short)(ny * MAP_WIDTH + nx),
+        (unsigned short)(py * MAP_WIDTH + px)
+    };
+
+    for (int g = 0; g < 2; g++) {
+        for (unsigned short c = gates[g]; c != start; c = from[c]) {
+            const unsigned short x = c % MAP_WIDTH;
+            const unsigned short y = c / MAP_WIDTH;
+            if (m.at(x, y).getType() == _TileType::SOLID){
+                m.set(x, y, _Tile(_TileType::DESTRUCTIBLE, x, y));
+            }
+        }
+    }
+}
+
+//!SECTION
+
+// SECTION ENEMIES
+
+/**
+ * @brief returns the end of a patroller path starting at (x,y)
+ *
+ * the path goes straight in the first direction with a walkable
+ * cell, ex,ey stay x,y if there is none
+ */
+static void patrolEnd(const Map& m, unsigned short x, unsigned short y,
+unsigned short& ex, unsigned short& ey) {
+    static const int DX[4] = {1, 0, -1, 0};
+    static const int DY[4] = {0, 1, 0, -1};
+
+    ex = x;
+    ey = y;
+    for (int d = 0; d < 4 && ex == x && ey == y; d++) {
+        for (int i = 1; i <= PATROL_LENGTH; i++) {
+            const unsigned short tx = (unsigned short)(x + DX[d] * i);
+            const unsigned short ty = (unsigned short)(y + DY[d] * i);
+            if (!isWalkableTile(m, tx, ty)){
+                break;
+            }
+            ex = tx;
+            ey = ty;
+        }
+    }
+}
+
+void MapGenerator::placeEnemies(Map& m, Random& rng, unsigned short* cells,
+int count) const {
+    const MapGenerator::Params& p = this->params;
+    const int total = p.walkers + p.chasers + p.patrollers;
+
+    int placed = 0;
+    while (placed < total && count > 0) {
+        // partial shuffle, every cell is drawn at most once
+        const int pick = rng.nextInt(0, count - 1);
+        const unsigned short cell = cells[pick];
+        cells[pick] = cells[--count];
+
+        const unsigned short x = cell % MAP_WIDTH;
+        const unsigned short y = cell / MAP_WIDTH;
+
+        // enemies replace destructible walls, never solid blocks
+        const _TileType t = m.at(x, y).getType();
+        if (t != _TileType::EMPTY && t != _TileType::DESTRUCTIBLE){
+            continue;
+        }
+
+        if (placed < p.walkers) {
+            m.spawnWalker(x, y, p.walkerSpeed);
+        } else if (placed < p.walkers + p.chasers) {
+            m.spawnChaser(x, y, p.chaserSpeed);
+        } else {
+            m.set(x, y, _Tile(_TileType::EMPTY, x, y));
+            unsigned short ex = x, ey = y;
+            patrolEnd(m, x, y, ex, ey);
+
+            // an enclosed cell gives a patroller that never moves
+            if (ex == x && ey == y) {
+                m.set(x, y, _Tile(t, x, y));
+                continue;
+            }
+            m.spawnPatroller(x, y, x, y, ex, ey, p.patrollerSpeed);
+        }
+        placed++;
+    }
+}
+
+//!SECTION
@@ -0,0 +1,145 @@
+/**
+ * @file map_generator.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief seeded procedural map generator
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the MapGenerator class, which builds random
+ * maps in the same format as the MapBuilder ones
+ *
+ * a generated map has solid pillars, destructible walls, enemies
+ * of every kind, a spawn and both gates, and the gates can always
+ * be reached from the spawn, walking or bombing destructible walls
+ *
+ * the same seed and the same parameters always give the same map
+ *
+ */
+
+#ifndef MAP_GENERATOR_HPP
+#define MAP_GENERATOR_HPP
+
+#include "maps.hpp"
+#include "random.hpp"
+
+/**
+ * @brief builds random playable maps from a seed
+ */
+class MapGenerator {
+public:
+    /**
+     * @brief shape and content of the generated maps
+     *
+     * cells outside width x height are SOLID, counts are upper
+     * bounds (a crowded map gets fewer enemies)
+     */
+    struct Params {
+        // playable area, border included (7 .. MAP_WIDTH/MAP_HEIGHT)
+        unsigned short width = MAP_WIDTH;
+        unsigned short height = MAP_HEIGHT;
+
+        // SOLID pillar on every cell with both coordinates even
+        bool pillars = true;
+
+        // percent of the free cells turned into SOLID blocks (0 .. 50)
+        int blockPercent = 0;
+
+        // percent of the free cells turned into DESTRUCTIBLE walls
+        int wallPercent = 40;
+
+        int walkers = 6;
+        int chasers = 3;
+        int patrollers = 3;
+
+        unsigned short walkerSpeed = 12;
+        unsigned short chaserSpeed = 10;
+        unsigned short patrollerSpeed = 8;
+    };
+
+private:
+    MapGenerator::Params params;
+
+    /**
+     * @brief returns true if (x,y) gets a pillar
+     */
+    bool isPillar(unsigned short x, unsigned short y) const;
+
+    /**
+     * @brief returns true if (x,y) is inside the area, border excluded
+     */
+    bool isInterior(unsigned short x, unsigned short y) const;
+
+    /**
+     * @brief fills the map with the border, pillars, blocks and walls
+     */
+    void placeTerrain(Map& m, Random& rng) const;
+
+    /**
+     * @brief places the spawn on a random cell and clears the cells
+     * around it
+     */
+    void placeSpawn(Map& m, Random& rng, unsigned short& sx,
+    unsigned short& sy) const;
+
+    /**
+     * @brief stores in cells the indices (y * MAP_WIDTH + x) that can
+     * hold a gate or an enemy, returns how many
+     */
+    int collectCells(unsigned short sx, unsigned short sy,
+    unsigned short* cells) const;
+
+    /**
+     * @brief removes a random cell from cells and returns it
+     *
+     * @param far if true, the farthest from the spawn of a few picks
+     */
+    unsigned short pickGate(Random& rng, unsigned short* cells,
+    int& count, unsigned short sx, unsigned short sy, bool far) const;
+
+    /**
+     * @brief turns into DESTRUCTIBLE the fewest SOLID cells that
+     * separate each gate from the spawn
+     */
+    void connect(Map& m, unsigned short sx, unsigned short sy,
+    unsigned short nx, unsigned short ny, unsigned short px,
+    unsigned short py) const;
+
+    /**
+     * @brief places the enemies on cells drawn from cells
+     */
+    void placeEnemies(Map& m, Random& rng, unsigned short* cells,
+    int count) const;
+
+public:
+    /**
+     * @brief creates a generator with the default parameters
+     * (a full size classic map)
+     */
+    MapGenerator();
+
+    /**
+     * @brief creates a generator, out of range parameters are clamped
+     */
+    MapGenerator(const MapGenerator::Params& params);
+
+    /**
+     * @brief returns the parameters in use, after clamping
+     */
+    const MapGenerator::Params& getParams() const;
+
+    /**
+     * @brief builds the map of a seed into out
+     *
+     * makes no heap allocation, out is overwritten completely
+     */
+    void generate(unsigned long long seed, Map& out) const;
+
+    /**
+     * @brief returns the map of a seed
+     */
+    Map generate(unsigned long long seed) const;
+};
+
+#endif
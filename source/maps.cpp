@@ -11,245 +11,7 @@
 
 #include "maps.hpp"
 
-_Tile::_Tile(_TileType type){
-    this->type = type;
-}
-
-_Tile::_Tile() {
-    this->type = _TileType::EMPTY;
-}
-
-_TileType _Tile::getType() const {
-    return this->type;
-}
-
-_Tile::_Tile(_TileType type, unsigned short x, 
-unsigned short y){
-
-        this->type = type;
-        this->sx = x;
-        this->sy = y;
-
-}
-
-_Tile::_Tile(_TileType type, unsigned short sx,
-unsigned short sy, unsigned short ex, unsigned short ey){
-        this->type = type;
-
-        this->sx = sx;
-        this->ex = ex;
-
-        this->sy = sy;
-        this->ey = ey;
-}
-
-_Tile::_Tile(_TileType type, unsigned short sx,
-unsigned short sy, unsigned short ex,
-unsigned short ey, unsigned short speed){
-    this->ex = ex;
-    this->ey = ey;
-    this->speed = speed;
-    this->sy = sy;
-    this->sx = sx;
-    this->type = type;
-}
-
-unsigned short _Tile::getStartX() const{
-    return this->sx;
-}
-
-unsigned short _Tile::getEndX() const{
-    return this->ex;
-}
-
-unsigned short _Tile::getStartY() const{
-    return this->sy;
-}
-
-unsigned short _Tile::getEndY() const{
-    return this->ey;
-}
-
-Map::Map(){
-    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
-        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
-            grid[y][x] = _Tile(_TileType::EMPTY);
-        }
-    }
-}
-
-void Map::spawnPatroller(unsigned short x ,unsigned short y ,
-unsigned short sx, unsigned short sy,unsigned short ex, 
-unsigned short ey, unsigned short speed){
-    _Tile t(
-        _TileType::PATROLLER,
-        sx,sy,
-        ex,ey,
-        speed
-    );
-
-    this->grid[y][x] = t;
-}
-
-void Map::spawnChaser(unsigned short x, unsigned short y,
-unsigned short speed) {
-    _Tile t(
-        _TileType::CHASER,
-        x,y,
-        0,0,
-        speed
-    );
-
-    this->grid[y][x] = t;
-}
-
-void Map::spawnWalker(unsigned short x, unsigned short y,
-unsigned short speed){
-    _Tile t(
-        _TileType::WALKER,
-        x,y,
-        0,0,
-        speed
-    );
-
-    this->grid[y][x] = t;
-}
-
-void Map::placeTile(unsigned short x, unsigned short y, _Tile t){
-    this->grid[y][x] = t;
-}
-
-bool Map::isValidFillType(_TileType t){
-    return (t == _TileType::SOLID ||
-    t == _TileType::DESTRUCTIBLE ||
-    t == _TileType::EMPTY);
-}
-
-void Map::row(unsigned short y,
-unsigned short x1, unsigned short x2,
-_TileType t){
-    if (!Map::isValidFillType(t)){
-        return;
-    }
-    if (y >= MAP_HEIGHT){
-        return;
-    }
-
-    if (x1 > x2) {
-        unsigned short tmp = x1;
-        x1 = x2;
-        x2 = tmp;
-    }
-
-    if (x2 >= MAP_WIDTH){
-        x2 = MAP_WIDTH - 1;
-    }
-
-    for (unsigned short x = x1; x <= x2; x++) {
-        this->grid[y][x] = _Tile(
-            t,x,y
-        );
-    }
-}
-
-void Map::column(unsigned short x,
-unsigned short y1, unsigned short y2,
-_TileType t){
-    if (!Map::isValidFillType(t)){
-        return;
-    }
-
-    if (x >= MAP_WIDTH)
-        return;
-
-    if (y1 > y2) {
-        unsigned short tmp = y1;
-        y1 = y2;
-        y2 = tmp;
-    }
-
-    if (y1 >= MAP_HEIGHT){
-        return;
-    }
-    if (y2 >= MAP_HEIGHT){
-        y2 = MAP_HEIGHT - 1;
-    }
-
-    for (unsigned short y = y1; y <= y2; ++y) {
-        this->grid[y][x] = _Tile(
-            t,x,y
-        );
-    }
-}
-
-void Map::fill(unsigned short x1, unsigned short y1,
-unsigned short x2, unsigned short y2, _TileType t) {
-    if (!Map::isValidFillType(t)){
-        return;
-    }
-
-    if (x1 > x2) {
-        unsigned short tmp = x1;
-        x1 = x2;
-        x2 = tmp;
-    }
-
-    if (y1 > y2) {
-        unsigned short tmp = y1;
-        y1 = y2;
-        y2 = tmp;
-    }
-
-    if (x1 >= MAP_WIDTH || y1 >= MAP_HEIGHT){
-        return;
-    }
-
-    if (x2 >= MAP_WIDTH){
-        x2 = MAP_WIDTH - 1;
-    }
-    if (y2 >= MAP_HEIGHT){
-        y2 = MAP_HEIGHT - 1;
-    }
-
-    for (unsigned short y = y1; y <= y2; ++y) {
-        for (unsigned short x = x1; x <= x2; ++x) {
-            this->grid[y][x] = _Tile(
-                t,x,y
-            );
-        }
-    }
-}
-
-void Map::borderWalls(){
-    //top and bottom
-    for (unsigned short x = 0; x < MAP_WIDTH; x++) {
-        this->placeTile(x, 0, _Tile(
-            _TileType::SOLID,x,0
-        ));
-        this->placeTile(x, MAP_HEIGHT - 1, _Tile(
-            _TileType::SOLID,x,MAP_HEIGHT -1
-        )); 
-    }
-
-    // left and right
-    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
-        this->placeTile(0, y, _Tile(
-            _TileType::SOLID,0,y
-        ));
-        this->placeTile(MAP_WIDTH - 1, y, _Tile(
-            _TileType::SOLID, MAP_WIDTH - 1, y
-        ));
-    }
-}
-
-void Map::setSpawn(unsigned short x, unsigned short y){
-    this->grid[y][x] = _Tile(
-        _TileType::SPAWN,x,y
-    );
-}
-
-// debug map
-Map MapBuilder::outsand() {
+static constexpr Map buildOutsand() {
     Map m;
 
     m.placeTile(MAP_WIDTH-2, MAP_HEIGHT-2, _Tile(
@@ -318,7 +80,7 @@ Map MapBuilder::outsand() {
     return m;
 }
 
-Map MapBuilder::crossroads() {
+static constexpr Map buildCrossroads() {
     Map m;
 
     const unsigned short W = m.width();
@@ -365,7 +127,8 @@ Map MapBuilder::crossroads() {
     m.placeTile(3, 2, _TileType::EMPTY);
     m.placeTile(3, 3, _TileType::EMPTY);
 
-    m.spawnPatroller( cx, 3,   3, 3,   W - 4, 3,   6);
+    // ends before the top right block (W - 6 .. W - 4)
+    m.spawnPatroller( cx, 3,   3, 3,   W - 7, 3,   6);
 
     m.spawnWalker(cx - 1, cy - 1, 10);
 
@@ -378,27 +141,7 @@ Map MapBuilder::crossroads() {
     return m;
 }
 
-unsigned short Map::width() const {
-    return MAP_WIDTH;
-}
-
-unsigned short Map::height() const {
-    return MAP_HEIGHT;
-}
-
-const _Tile& Map::at(unsigned short x, unsigned short y) const {
-    return this->grid[y][x];
-}
-
-void Map::set(unsigned short x, unsigned short y, _Tile tile) {
-    this->grid[y][x] = tile;
-}
-
-unsigned short _Tile::getSpeed() const {
-    return this->speed;
-}
-
-Map MapBuilder::motherboard(){
+static constexpr Map buildMotherboard() {
     Map m;
 
     m.setSpawn(1,20);
@@ -459,7 +202,7 @@ Map MapBuilder::motherboard(){
 }
 
 
-Map MapBuilder::ram(){
+static constexpr Map buildRam() {
 
 
     Map m;
@@ -599,7 +342,7 @@ Map MapBuilder::ram(){
     return m;
 }
 
-Map MapBuilder::storage(){
+static constexpr Map buildStorage() {
     Map m;
 
     m.setSpawn(1,11);
@@ -698,7 +441,7 @@ Map MapBuilder::storage(){
     return m;
 }
 
-Map MapBuilder::cpu(){
+static constexpr Map buildCpu() {
     Map m;
 
     m.setSpawn(1,2);
@@ -816,7 +559,7 @@ Map MapBuilder::cpu(){
 
 }
 
-Map MapBuilder::gpu(){
+static constexpr Map buildGpu() {
     Map m;
     
     m.fill(7,11,10,12,_TileType::DESTRUCTIBLE);
@@ -957,3 +700,59 @@ Map MapBuilder::gpu(){
 
     return m;
 }
+
+// SECTION TABLES
+
+static constexpr Map OUTSAND = buildOutsand();
+static constexpr Map CROSSROADS = buildCrossroads();
+static constexpr Map MOTHERBOARD = buildMotherboard();
+static constexpr Map RAM = buildRam();
+static constexpr Map STORAGE = buildStorage();
+static constexpr Map CPU = buildCpu();
+static constexpr Map GPU = buildGpu();
+
+// the same rules the bonus parser checks at runtime
+#define CHECK_MAP(m, name) \
+    static_assert((m).spawnCount() == 1, name ": needs one spawn"); \
+    static_assert((m).gatesOffBorder(), name ": gate on the border"); \
+    static_assert((m).enemiesOnWalkable(), name ": enemy on a wall")
+
+CHECK_MAP(OUTSAND, "outsand");
+CHECK_MAP(CROSSROADS, "crossroads");
+CHECK_MAP(MOTHERBOARD, "motherboard");
+CHECK_MAP(RAM, "ram");
+CHECK_MAP(STORAGE, "storage");
+CHECK_MAP(CPU, "cpu");
+CHECK_MAP(GPU, "gpu");
+
+#undef CHECK_MAP
+
+const Map& MapBuilder::outsand() {
+    return OUTSAND;
+}
+
+const Map& MapBuilder::crossroads() {
+    return CROSSROADS;
+}
+
+const Map& MapBuilder::motherboard() {
+    return MOTHERBOARD;
+}
+
+const Map& MapBuilder::ram() {
+    return RAM;
+}
+
+const Map& MapBuilder::storage() {
+    return STORAGE;
+}
+
+const Map& MapBuilder::cpu() {
+    return CPU;
+}
+
+const Map& MapBuilder::gpu() {
+    return GPU;
+}
+
+//!SECTION
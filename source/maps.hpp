@@ -70,13 +70,13 @@ public:
     /**
      * @brief creates an empty tile
      */
-    _Tile();
+    constexpr _Tile();
 
     /**
      * @brief creates a tile with a given type
      * @param type tile type
      */
-    _Tile(_TileType type);
+    constexpr _Tile(_TileType type);
 
     /**
      * @brief creates a tile with a type and a single coordinate pair
@@ -87,7 +87,7 @@ public:
      * @param x X value stored in sx
      * @param y Y value stored in sy
      */
-    _Tile(_TileType type, unsigned short x,
+    constexpr _Tile(_TileType type, unsigned short x,
     unsigned short y);
 
     /**
@@ -98,7 +98,7 @@ public:
      * @param ex end X
      * @param ey end Y
      */
-    _Tile(_TileType type, unsigned short sx,
+    constexpr _Tile(_TileType type, unsigned short sx,
     unsigned short sy, unsigned short ex, unsigned short ey);
 
     /**
@@ -110,39 +110,39 @@ public:
      * @param ey end Y
      * @param speed speed parameter
      */
-    _Tile(_TileType type, unsigned short sx,
+    constexpr _Tile(_TileType type, unsigned short sx,
     unsigned short sy, unsigned short ex,
     unsigned short ey, unsigned short speed);
 
     /**
      * @brief returns the tile type
      */
-    _TileType getType() const;
+    constexpr _TileType getType() const;
 
      /**
      * @brief returns the start X value
      */   
-    unsigned short getStartX() const;
+    constexpr unsigned short getStartX() const;
 
     /**
      * @brief returns the end X value
      */    
-    unsigned short getEndX() const; 
+    constexpr unsigned short getEndX() const; 
 
      /**
      * @brief returns the start Y value
      */   
-    unsigned short getStartY() const;
+    constexpr unsigned short getStartY() const;
 
     /**
      * @brief returns the end Y value
      */    
-    unsigned short getEndY() const; 
+    constexpr unsigned short getEndY() const; 
 
     /**
      * @brief returns the speed parameter
      */
-    unsigned short getSpeed() const;
+    constexpr unsigned short getSpeed() const;
 
 };
 
@@ -167,14 +167,14 @@ private:
      * @return true if the type is safe to 
      * use for row/column/fill helpers
      */
-    static bool isValidFillType(_TileType t);
+    static constexpr bool isValidFillType(_TileType t);
 
 public:
 
     /**
      * @brief creates a map filled with EMPTY tiles
      */
-    Map();
+    constexpr Map();
 
     /**
      * @brief sets a tile in the grid
@@ -182,7 +182,7 @@ public:
      * @param y Y coordinate
      * @param tile tile value to store
      */
-    void set(unsigned short x, unsigned short y, _Tile tile);
+    constexpr void set(unsigned short x, unsigned short y, _Tile tile);
 
     /**
      * @brief returns a const reference to a tile in the grid
@@ -190,17 +190,17 @@ public:
      * @param y Y coordinate
      * @return const reference to the stored tile
      */    
-    const _Tile& at(unsigned short x, unsigned short y) const;
+    constexpr const _Tile& at(unsigned short x, unsigned short y) const;
 
     /**
      * @brief returns map width
      */
-    unsigned short width() const;
+    constexpr unsigned short width() const;
 
     /**
      * @brief returns map height
      */
-    unsigned short height() const; 
+    constexpr unsigned short height() const; 
 
 
     /**
@@ -213,7 +213,7 @@ public:
      * @param ey path end Y
      * @param speed movement speed
      */
-    void spawnPatroller(unsigned short x ,unsigned short y ,
+    constexpr void spawnPatroller(unsigned short x ,unsigned short y ,
     unsigned short sx, unsigned short sy,
     unsigned short ex, unsigned short ey, unsigned short speed);
 
@@ -223,7 +223,7 @@ public:
      * @param y tile Y
      * @param speed movement speed (default 10)
      */
-    void spawnChaser(unsigned short x, unsigned short y,
+    constexpr void spawnChaser(unsigned short x, unsigned short y,
     unsigned short speed = 10);
 
     /**
@@ -232,7 +232,7 @@ public:
      * @param y tile Y
      * @param speed movement speed (default 12)
      */
-    void spawnWalker(unsigned short x, unsigned short y,
+    constexpr void spawnWalker(unsigned short x, unsigned short y,
     unsigned short speed = 12);
 
     /**
@@ -241,7 +241,7 @@ public:
      * @param y tile Y
      * @param t tile value
      */
-    void placeTile(unsigned short x, unsigned short y, _Tile t);
+    constexpr void placeTile(unsigned short x, unsigned short y, _Tile t);
 
     /**
      * @brief fills a horizontal segment on row y
@@ -250,7 +250,7 @@ public:
      * @param x2 end X
      * @param t tile type to place
      */
-    void row(unsigned short y,
+    constexpr void row(unsigned short y,
     unsigned short x1, unsigned short x2,
     _TileType t);
 
@@ -261,7 +261,7 @@ public:
      * @param y2 end Y
      * @param t tile type to place
      */
-    void column(unsigned short x,
+    constexpr void column(unsigned short x,
     unsigned short y1, unsigned short y2,
     _TileType t);
 
@@ -273,7 +273,7 @@ public:
      * @param y2 bottom Y
      * @param t tile type to place
      */
-    void fill(unsigned short x1, unsigned short y1,
+    constexpr void fill(unsigned short x1, unsigned short y1,
     unsigned short x2, unsigned short y2, _TileType t);
 
     /**
@@ -281,16 +281,38 @@ public:
      *
      * @note always use this method after map creation
      */
-    void borderWalls();
+    constexpr void borderWalls();
 
     /**
      * @brief sets the player spawn marker
      * @param x spawn X
      * @param y spawn Y
      */
-    void setSpawn(unsigned short x, unsigned short y);
+    constexpr void setSpawn(unsigned short x, unsigned short y);
+
+    /**
+     * @brief returns the number of SPAWN tiles
+     */
+    constexpr int spawnCount() const;
+
+    /**
+     * @brief returns true if no gate is on the border
+     */
+    constexpr bool gatesOffBorder() const;
+
+    /**
+     * @brief returns true if every enemy starts (and a patroller
+     * also ends) inside the map on a walkable tile
+     */
+    constexpr bool enemiesOnWalkable() const;
 };
 
+/**
+ * @brief the builtin maps
+ *
+ * every map is built at compile time and stored as a read-only
+ * table, its validity is checked with static_assert (maps.cpp)
+ */
 class MapBuilder {
 public:
     // debug map 1
@@ -300,7 +322,7 @@ public:
      * @author Martina Lisa Saffo Ramponi
      * 
      */
-    static Map outsand(); 
+    static const Map& outsand(); 
 
     // debug map 2
     /**
@@ -309,43 +331,371 @@ public:
      * @author Martina Lisa Saffo Ramponi
      * 
      */
-    static Map crossroads();
+    static const Map& crossroads();
 
     /**
      * @brief first level map
      * 
      * @author Martina Nazzareni
      */
-    static Map motherboard();
+    static const Map& motherboard();
 
     /**
      * @brief second level map
      * 
      * @author Martina Nazzareni
      */    
-    static Map ram();
+    static const Map& ram();
 
     /**
      * @brief third level map
      * 
      * @author Martina Nazzareni
      */   
-    static Map storage();
+    static const Map& storage();
 
     /**
      * @brief fourth level map
      * 
      * @author Martina Nazzareni
      */   
-    static Map cpu();
+    static const Map& cpu();
 
     /**
      * @brief fifth level map
      * 
      * @author Martina Nazzareni
      */   
-    static Map gpu();
+    static const Map& gpu();
 
 };
 
+// SECTION CONSTEXPR DEFINITIONS
+// a constexpr function must be visible wherever it is used,
+// so tiles and maps are defined here instead of in maps.cpp
+
+constexpr _Tile::_Tile(_TileType type){
+    this->type = type;
+}
+
+constexpr _Tile::_Tile() {
+    this->type = _TileType::EMPTY;
+}
+
+constexpr _TileType _Tile::getType() const {
+    return this->type;
+}
+
+constexpr _Tile::_Tile(_TileType type, unsigned short x, 
+unsigned short y){
+
+        this->type = type;
+        this->sx = x;
+        this->sy = y;
+
+}
+
+constexpr _Tile::_Tile(_TileType type, unsigned short sx,
+unsigned short sy, unsigned short ex, unsigned short ey){
+        this->type = type;
+
+        this->sx = sx;
+        this->ex = ex;
+
+        this->sy = sy;
+        this->ey = ey;
+}
+
+constexpr _Tile::_Tile(_TileType type, unsigned short sx,
+unsigned short sy, unsigned short ex,
+unsigned short ey, unsigned short speed){
+    this->ex = ex;
+    this->ey = ey;
+    this->speed = speed;
+    this->sy = sy;
+    this->sx = sx;
+    this->type = type;
+}
+
+constexpr unsigned short _Tile::getStartX() const{
+    return this->sx;
+}
+
+constexpr unsigned short _Tile::getEndX() const{
+    return this->ex;
+}
+
+constexpr unsigned short _Tile::getStartY() const{
+    return this->sy;
+}
+
+constexpr unsigned short _Tile::getEndY() const{
+    return this->ey;
+}
+
+constexpr Map::Map(){
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            grid[y][x] = _Tile(_TileType::EMPTY);
+        }
+    }
+}
+
+constexpr void Map::spawnPatroller(unsigned short x ,unsigned short y ,
+unsigned short sx, unsigned short sy,unsigned short ex, 
+unsigned short ey, unsigned short speed){
+    _Tile t(
+        _TileType::PATROLLER,
+        sx,sy,
+        ex,ey,
+        speed
+    );
+
+    this->grid[y][x] = t;
+}
+
+constexpr void Map::spawnChaser(unsigned short x, unsigned short y,
+unsigned short speed) {
+    _Tile t(
+        _TileType::CHASER,
+        x,y,
+        0,0,
+        speed
+    );
+
+    this->grid[y][x] = t;
+}
+
+constexpr void Map::spawnWalker(unsigned short x, unsigned short y,
+unsigned short speed){
+    _Tile t(
+        _TileType::WALKER,
+        x,y,
+        0,0,
+        speed
+    );
+
+    this->grid[y][x] = t;
+}
+
+constexpr void Map::placeTile(unsigned short x, unsigned short y, _Tile t){
+    this->grid[y][x] = t;
+}
+
+constexpr bool Map::isValidFillType(_TileType t){
+    return (t == _TileType::SOLID ||
+    t == _TileType::DESTRUCTIBLE ||
+    t == _TileType::EMPTY);
+}
+
+constexpr void Map::row(unsigned short y,
+unsigned short x1, unsigned short x2,
+_TileType t){
+    if (!Map::isValidFillType(t)){
+        return;
+    }
+    if (y >= MAP_HEIGHT){
+        return;
+    }
+
+    if (x1 > x2) {
+        unsigned short tmp = x1;
+        x1 = x2;
+        x2 = tmp;
+    }
+
+    if (x2 >= MAP_WIDTH){
+        x2 = MAP_WIDTH - 1;
+    }
+
+    for (unsigned short x = x1; x <= x2; x++) {
+        this->grid[y][x] = _Tile(
+            t,x,y
+        );
+    }
+}
+
+constexpr void Map::column(unsigned short x,
+unsigned short y1, unsigned short y2,
+_TileType t){
+    if (!Map::isValidFillType(t)){
+        return;
+    }
+
+    if (x >= MAP_WIDTH)
+        return;
+
+    if (y1 > y2) {
+        unsigned short tmp = y1;
+        y1 = y2;
+        y2 = tmp;
+    }
+
+    if (y1 >= MAP_HEIGHT){
+        return;
+    }
+    if (y2 >= MAP_HEIGHT){
+        y2 = MAP_HEIGHT - 1;
+    }
+
+    for (unsigned short y = y1; y <= y2; ++y) {
+        this->grid[y][x] = _Tile(
+            t,x,y
+        );
+    }
+}
+
+constexpr void Map::fill(unsigned short x1, unsigned short y1,
+unsigned short x2, unsigned short y2, _TileType t) {
+    if (!Map::isValidFillType(t)){
+        return;
+    }
+
+    if (x1 > x2) {
+        unsigned short tmp = x1;
+        x1 = x2;
+        x2 = tmp;
+    }
+
+    if (y1 > y2) {
+        unsigned short tmp = y1;
+        y1 = y2;
+        y2 = tmp;
+    }
+
+    if (x1 >= MAP_WIDTH || y1 >= MAP_HEIGHT){
+        return;
+    }
+
+    if (x2 >= MAP_WIDTH){
+        x2 = MAP_WIDTH - 1;
+    }
+    if (y2 >= MAP_HEIGHT){
+        y2 = MAP_HEIGHT - 1;
+    }
+
+    for (unsigned short y = y1; y <= y2; ++y) {
+        for (unsigned short x = x1; x <= x2; ++x) {
+            this->grid[y][x] = _Tile(
+                t,x,y
+            );
+        }
+    }
+}
+
+constexpr void Map::borderWalls(){
+    //top and bottom
+    for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+        this->placeTile(x, 0, _Tile(
+            _TileType::SOLID,x,0
+        ));
+        this->placeTile(x, MAP_HEIGHT - 1, _Tile(
+            _TileType::SOLID,x,MAP_HEIGHT -1
+        )); 
+    }
+
+    // left and right
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        this->placeTile(0, y, _Tile(
+            _TileType::SOLID,0,y
+        ));
+        this->placeTile(MAP_WIDTH - 1, y, _Tile(
+            _TileType::SOLID, MAP_WIDTH - 1, y
+        ));
+    }
+}
+
+constexpr void Map::setSpawn(unsigned short x, unsigned short y){
+    this->grid[y][x] = _Tile(
+        _TileType::SPAWN,x,y
+    );
+}
+
+// debug map
+constexpr unsigned short Map::width() const {
+    return MAP_WIDTH;
+}
+
+constexpr unsigned short Map::height() const {
+    return MAP_HEIGHT;
+}
+
+constexpr const _Tile& Map::at(unsigned short x, unsigned short y) const {
+    return this->grid[y][x];
+}
+
+constexpr void Map::set(unsigned short x, unsigned short y, _Tile tile) {
+    this->grid[y][x] = tile;
+}
+
+constexpr unsigned short _Tile::getSpeed() const {
+    return this->speed;
+}
+
+constexpr int Map::spawnCount() const {
+    int n = 0;
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            if (this->grid[y][x].getType() == _TileType::SPAWN){
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+constexpr bool Map::gatesOffBorder() const {
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            _TileType t = this->grid[y][x].getType();
+            if (t != _TileType::GATE_NEXT && t != _TileType::GATE_PREV){
+                continue;
+            }
+            if (x == 0 || y == 0 || x == MAP_WIDTH - 1 ||
+            y == MAP_HEIGHT - 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief true if (x,y) is inside the map and not a wall
+ */
+constexpr bool isWalkableTile(const Map& m, unsigned short x,
+unsigned short y) {
+    if (x >= MAP_WIDTH || y >= MAP_HEIGHT){
+        return false;
+    }
+    _TileType t = m.at(x, y).getType();
+    return t != _TileType::SOLID && t != _TileType::DESTRUCTIBLE;
+}
+
+constexpr bool Map::enemiesOnWalkable() const {
+    for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+            const _Tile& t = this->grid[y][x];
+            _TileType type = t.getType();
+
+            if (type != _TileType::WALKER && type != _TileType::CHASER &&
+            type != _TileType::PATROLLER) {
+                continue;
+            }
+
+            if (!isWalkableTile(*this, t.getStartX(), t.getStartY())){
+                return false;
+            }
+
+            if (type == _TileType::PATROLLER &&
+            !isWalkableTile(*this, t.getEndX(), t.getEndY())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//!SECTION
+
 #endif
@@ -10,9 +10,23 @@
  */
 
 #include "menu.hpp"
+#include "input.hpp"
 #include "render.hpp"
+#include <chrono>
 #include <ncurses.h>
 
+// one animation step of the menu (sparkle, title, dots)
+static const int MENU_STEP_MS = 30;
+
+// without input for this long the animation pauses
+static const int MENU_IDLE_MS = 60000;
+
+static long long msSince(std::chrono::steady_clock::time_point t) {
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t
+    ).count();
+}
+
 Menu::Menu() : selectedItem(0) {}
 
 void Menu::resetCheat() {
@@ -48,17 +62,36 @@ static bool matchBombergirl(const char* buf, int len) {
 }
 
 Menu::Result Menu::run() {
-    nodelay(stdscr, TRUE);
+    const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastInput = start;
+
+    long long drawnStep = -1;
+    bool dirty = true;
 
     while (true) {
-        Render::drawMenu(selectedItem);
+        long long elapsed = msSince(start);
+        long long step = elapsed / MENU_STEP_MS;
+        bool idle = msSince(lastInput) >= MENU_IDLE_MS;
+
+        if (dirty || (!idle && step != drawnStep)) {
+            Render::drawMenu(selectedItem, (int)step);
+            drawnStep = step;
+            dirty = false;
+        }
 
-        int ch = getch();
+        // sleep until the next step (or a key)
+        int timeout = idle ? Input::WAIT_FOREVER
+        : MENU_STEP_MS - (int)(elapsed % MENU_STEP_MS);
+
+        int ch = Input::waitKey(timeout);
         if (ch == ERR) {
-            napms(30);
             continue;
         }
 
+        lastInput = std::chrono::steady_clock::now();
+        dirty = true;
+
         if (ch == KEY_RESIZE) {
             Render::handleResize();
 
@@ -135,7 +168,6 @@ Menu::Result Menu::run() {
             default:
                 break;
         }
-        napms(30);
     }
 }
 
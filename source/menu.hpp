@@ -61,6 +61,10 @@ public:
      * this method handles keyboard input,
      * updates the selection, and returns a Result
      *
+     * the menu sleeps between animation steps and redraws only when
+     * a key arrives or a step is due; after a while without input the
+     * animation pauses and the menu just waits for a key
+     *
      * @return the chosen menu action
      */
     Result run();
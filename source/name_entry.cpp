@@ -10,6 +10,7 @@
  */
 
 #include "name_entry.hpp"
+#include "input.hpp"
 
 /**
  * @brief clamp an integer value to an 
@@ -53,13 +54,12 @@ bool NameEntry::run(char outName[4], int score, bool victory) {
     int idx = 0;
     int vals[3] = {0,0,0}; 
 
-    nodelay(stdscr, FALSE);
     keypad(stdscr, TRUE);
 
     while (true) {
         Render::drawNameEntry(outName, idx, score, victory);
 
-        int ch = getch();
+        int ch = Input::waitKey(Input::WAIT_FOREVER);
 
         if (ch == 'q' || ch == 'Q') {
             nodelay(stdscr, TRUE);
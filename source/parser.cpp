@@ -10,8 +10,21 @@
  */
 
 #include "parser.hpp"
+#include "alloc_tracker.hpp"
 
-#include <fstream>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// type;x;y;sx;sy;ex;ey;speed
+static const int FIELD_COUNT = 8;
+
+// largest value of the fields stored as unsigned short
+static const unsigned int FIELD_MAX = 65535;
 
 void Parser::setErr(char* err, int cap, const char* msg) {
     // same as strncpy
@@ -25,124 +38,235 @@ void Parser::setErr(char* err, int cap, const char* msg) {
     err[i] = '\0';
 }
 
-static const char* skipSpaces(const char* s) {
-    if (!s){
-        return s;
+void Parser::addError(Parser::Diagnostics* diag, int line, int column,
+const char* message) {
+    if (diag == nullptr){
+        return;
     }
-    while (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n'){
-        s++; // skipping spaces, tabs, \n and \r (windows carriage return)
+    diag->total++;
+    if (diag->count >= Parser::MAX_ERRORS){
+        return;
     }
-    return s;
+    Parser::Error& e = diag->errors[diag->count++];
+    e.line = line;
+    e.column = column;
+    e.message = message;
 }
 
-static bool split8(const char* line, char fields[8][32], int& outCount) {
-    outCount = 0;
-    if (!line){
-        return false;
+void Parser::formatError(const Parser::Error& e, char* err, int cap) {
+    if (!err || cap <= 0){
+        return;
     }
+    if (e.line == 0) {
+        Parser::setErr(err, cap, e.message);
+        return;
+    }
+    snprintf(err, (std::size_t)cap, "line %d, column %d: %s", e.line,
+    e.column, e.message);
+}
 
-    int fi = 0; //field
-    int ci = 0; // char
-
+static bool isSpace(char c) {
+    // \r: windows carriage return
+    return c == ' ' || c == '\t' || c == '\r';
+}
 
-    for (int i = 0; i < 8; i++){
-        fields[i][0] = '\0';
-    }
+static const char* const FIELD_RANGE[FIELD_COUNT] = {
+    "invalid _TileType value",
+    "x out of bounds",
+    "y out of bounds",
+    "number too large", "number too large",
+    "number too large", "number too large",
+    "number too large"
+};
 
-    for (int i = 0; ; i++) {
-        char ch = line[i];
-        if (ch == ';' || ch == '\0' || ch == '\n' || ch == '\r') {
-            if (fi >= 8){
-                return false;
-            }
-            fields[fi][ci] = '\0';
+/**
+ * @brief true at the end of a line, '\n' or the end of the data
+ */
+static bool atLineEnd(const char* q, const char* end) {
+    return q == end || *q == '\n';
+}
 
-            fi++;
-            outCount = fi;
+/**
+ * @brief returns the start of the line after the one holding q
+ */
+static const char* nextLine(const char* q, const char* end) {
+    const char* eol = (const char*)memchr(q, '\n', (std::size_t)(end - q));
+    return eol != nullptr ? eol + 1 : end;
+}
 
-            if (ch == '\0' || ch == '\n' || ch == '\r'){
-                break;
-            }
+/**
+ * @brief reads the 8 fields of the line starting at s in one pass
+ *
+ * numbers are converted where they are, spaces around a field are
+ * allowed, a line is never scanned twice
+ *
+ * @param limit largest allowed value of each field
+ * @param v converted values
+ * @param starts first character of each field
+ * @param at set to the wrong character on failure, to the end of
+ * the line on success
+ * @return nullptr on success, else the error message
+ */
+static const char* parseFields(const char* s, const char* end,
+const unsigned int* limit, unsigned int* v, const char** starts,
+const char*& at) {
+    const char* q = s;
+
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        while (q < end && isSpace(*q)){
+            q++;
+        }
+        at = q;
+        starts[i] = q;
 
-            //next field
-            if (fi >= 8) {
-                return false;
-            }
+        if (atLineEnd(q, end)){
+            return "missing fields, expected type;x;y;sx;sy;ex;ey;speed";
+        }
+        if (*q == ';'){
+            return "empty field";
+        }
+        if (*q == '-'){
+            return "negative value";
+        }
 
-            ci = 0;
-            continue;
+        // no locale, no allocation, overflow is reported
+        std::from_chars_result r = std::from_chars(q, end, v[i]);
+        if (r.ec == std::errc::result_out_of_range){
+            return "number too large";
+        }
+        if (r.ec != std::errc()){
+            return "not a number";
+        }
+        if (v[i] > limit[i]){
+            return FIELD_RANGE[i];
         }
 
-        if (fi >= 8){
-            return false;
+        q = r.ptr;
+        while (q < end && isSpace(*q)){
+            q++;
         }
+        at = q;
 
-        if (ci >= 31){
-            return false; 
+        if (i < FIELD_COUNT - 1) {
+            if (atLineEnd(q, end)){
+                return "missing fields, expected "
+                "type;x;y;sx;sy;ex;ey;speed";
+            }
+            if (*q != ';'){
+                return "unexpected character after the number";
+            }
+            q++;
+        } else if (!atLineEnd(q, end)) {
+            if (*q == ';'){
+                return "too many fields, expected "
+                "type;x;y;sx;sy;ex;ey;speed";
+            }
+            return "unexpected character after the number";
         }
-        fields[fi][ci++] = ch;
     }
 
-    return true;
+    return nullptr;
 }
 
-// casting strings into integers
-int Parser::parseInt(const char* s, bool& ok) {
-    ok = false;
-    if (s == NULL){
-        return 0;
+bool Parser::loadBonusFile(const char* path, 
+Map& outMap, char* err, int errCap) {
+    Parser::setErr(err, errCap, "");
+
+    Parser::Diagnostics diag;
+    if (Parser::parseFile(path, outMap, &diag)){
+        return true;
     }
 
-    s = skipSpaces(s);
-    if (*s == '\0'){
-        return 0;
+    Parser::formatError(diag.errors[0], err, errCap);
+    return false;
+}
+
+bool Parser::parseFile(const char* path, Map& outMap,
+Parser::Diagnostics* diag) {
+    if (diag != nullptr) {
+        diag->count = 0;
+        diag->total = 0;
     }
 
-    // no negative values (no value can be neg)
-    if (*s == '-'){
-        return 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        Parser::addError(diag, 0, 0, "cannot open the bonus file");
+        return false;
     }
 
-    unsigned int v = 0;
-    int digits = 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        Parser::addError(diag, 0, 0, "cannot read the bonus file");
+        return false;
+    }
 
-    while (*s >= '0' && *s <= '9') {
-        v = v * 10u + (unsigned int)(*s - '0');
-        digits++;
-        s++;
+    // an empty file can't be mapped, it has no tiles anyway
+    if (st.st_size == 0) {
+        close(fd);
+        return Parser::parseBuffer("", 0, outMap, diag);
     }
 
-    if (digits == 0){
-        return 0;
+    const std::size_t size = (std::size_t)st.st_size;
+    void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        Parser::addError(diag, 0, 0, "cannot read the bonus file");
+        return false;
     }
 
-    s = skipSpaces(s);
+    // read once from start to end
+    madvise(p, size, MADV_SEQUENTIAL);
 
-    if (*s != '\0'){
-        return 0;
-    }
-    ok = true;
-    return (int)v;
+    bool ok = Parser::parseBuffer((const char*)p, size, outMap, diag);
+    munmap(p, size);
+    return ok;
 }
 
-bool Parser::loadBonusFile(const char* path, 
-Map& outMap, char* err, int errCap) {
-    Parser::setErr(err, errCap, "");
+bool Parser::parseBuffer(const char* data, std::size_t size,
+Map& outMap, Parser::Diagnostics* diag) {
+    return Parser::parseLevel(data, size, MAP_WIDTH, MAP_HEIGHT, 1,
+    outMap, diag);
+}
 
-    std::ifstream in(path);
-    if (!in.is_open()) {
-        setErr(err, errCap, "Cannot open bonus CSV.");
-        return false;
+bool Parser::parseLevel(const char* data, std::size_t size,
+unsigned short width, unsigned short height, int firstLine,
+Map& outMap, Parser::Diagnostics* diag) {
+    AllocTracker::Scope tag(AllocTracker::Tag::PARSER);
+
+    // errors are counted here too, diag can be null
+    Parser::Diagnostics local;
+    if (diag == nullptr){
+        diag = &local;
     }
+    diag->count = 0;
+    diag->total = 0;
 
-    // reset a EMPTY
+    if (width > MAP_WIDTH){
+        width = MAP_WIDTH;
+    }
+    if (height > MAP_HEIGHT){
+        height = MAP_HEIGHT;
+    }
+
+    // reset a EMPTY, SOLID outside the level
     for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
         for (unsigned short x = 0; x < MAP_WIDTH; x++) {
-            _Tile t(_TileType::EMPTY, 0, 0, 0, 0);
-            outMap.set(x, y, t);
+            if (x < width && y < height) {
+                outMap.set(x, y, _Tile(_TileType::EMPTY, 0, 0, 0, 0));
+            } else {
+                outMap.set(x, y, _Tile(_TileType::SOLID));
+            }
         }
     }
 
+    // allowed range of each field, x and y depend on the level
+    const unsigned int limit[FIELD_COUNT] = {
+        (unsigned int)_TileType::GATE_PREV,
+        (unsigned int)width - 1, (unsigned int)height - 1,
+        FIELD_MAX, FIELD_MAX, FIELD_MAX, FIELD_MAX, FIELD_MAX
+    };
+
     bool used[MAP_HEIGHT][MAP_WIDTH];
     for (int yy = 0; yy < (int)MAP_HEIGHT; yy++) {
         for (int xx = 0; xx < (int)MAP_WIDTH; xx++) {
@@ -151,152 +275,120 @@ Map& outMap, char* err, int errCap) {
     }
 
     int spawnCount = 0;
-    int spawnX = 0;
-    int spawnY = 0;
-
     bool containsGate = false;
 
-    char line[256];
-    while (in.getline(line, sizeof(line))) {
-        const char* pLine = skipSpaces(line);
+    const char* p = data;
+    const char* const end = data + size;
+    int line = firstLine - 1;
 
-        if (!pLine || pLine[0] == '\0'){
-            continue; // skipping empty lines
-        }
+    while (p < end) {
+        line++;
 
-        //that's a comment, skip
-        if (pLine[0] == '#'){
-            continue;
+        const char* lineStart = p;
+
+        // columns count bytes from 1
+        auto column = [lineStart](const char* at) {
+            return (int)(at - lineStart) + 1;
+        };
+
+        const char* s = lineStart;
+        while (s < end && isSpace(*s)){
+            s++;
         }
 
-        // split (using ;)
-        char fields[8][32];
-        int nfields = 0;
-        if (!split8(pLine, fields, nfields)) {
-            // invalid format, line ignored
+        // empty line or comment, a comment is skipped with memchr
+        if (atLineEnd(s, end)) {
+            p = s < end ? s + 1 : end;
             continue;
         }
-
-        if (nfields != 8) {
+        if (*s == '#') {
+            p = nextLine(s, end);
             continue;
         }
-
-        // integer parsing 
-        // probably bool ok[8] would be better
-        bool ok0, ok1, ok2, ok3, ok4, ok5, ok6, ok7;
-        int typeI = parseInt(fields[0], ok0);
-        int x = parseInt(fields[1], ok1);
-        int y = parseInt(fields[2], ok2);
-        int sx = parseInt(fields[3], ok3);
-        int sy = parseInt(fields[4], ok4);
-        int ex = parseInt(fields[5], ok5);
-        int ey = parseInt(fields[6], ok6);
-        int speed = parseInt(fields[7], ok7);
-
-        //if something is missing ignore
-        if (!ok0 || !ok1 || !ok2 || !ok3 || 
-        !ok4 || !ok5 || !ok6 || !ok7) {
+        if (*s == '@') {
+            Parser::addError(diag, line, column(s),
+            "level header in a single level file");
+            p = nextLine(s, end);
             continue;
         }
 
-        // validate type
-        if (typeI < (int)_TileType::EMPTY || 
-            typeI > (int)_TileType::GATE_PREV) {
-            setErr(err, errCap, "Invalid _TileType value in CSV.");
-            in.close();
-            return false;
+        // fields are read in place, nothing is copied
+        unsigned int v[FIELD_COUNT];
+        const char* starts[FIELD_COUNT];
+        const char* at = nullptr;
+        const char* msg = parseFields(s, end, limit, v, starts,
+        at);
+        if (msg != nullptr) {
+            Parser::addError(diag, line, column(at), msg);
+            p = nextLine(at, end);
+            continue;
         }
+        p = at < end ? at + 1 : end;
 
-        // validate coords
-        if (x < 0 || y < 0 || 
-        x >= (int)MAP_WIDTH || y >= (int)MAP_HEIGHT) {
-            setErr(err, errCap, 
-            "Tile position out of bounds in CSV.");
-            in.close();
-            return false;
-        }
+        const unsigned short x = (unsigned short)v[1];
+        const unsigned short y = (unsigned short)v[2];
 
         // can't use the same coordinates twice
         if (used[y][x]) {
-            setErr(err, errCap, 
-            "Duplicate (x,y) entry in CSV.");
-            in.close();
-            return false;
+            Parser::addError(diag, line, column(starts[1]),
+            "duplicate (x,y), the cell is already set");
+            continue;
         }
-
         used[y][x] = true;
 
-        // clamp speed
-        if (speed < 0){
-            speed = 0;
-        }
-        if (speed > 65535){
-            speed = 65535;
-        }
-
-        _Tile t((_TileType)typeI, (unsigned short)sx, 
-        (unsigned short)sy, (unsigned short)ex, 
-        (unsigned short)ey, speed);
+        _Tile t((_TileType)v[0], (unsigned short)v[3], 
+        (unsigned short)v[4], (unsigned short)v[5], 
+        (unsigned short)v[6], (unsigned short)v[7]);
 
+        bool onBorder = (x == 0) || (y == 0) ||
+        (x == width - 1) || (y == height - 1);
 
-
-        outMap.set((unsigned short)x, (unsigned short)y, t);
-
-        if (t.getType() == _TileType::SPAWN){
+        if (t.getType() == _TileType::SPAWN) {
             spawnCount++;
-            spawnX = x;
-            spawnY = y;
+            if (spawnCount > 1) {
+                Parser::addError(diag, line, column(starts[0]),
+                "more than one SPAWN tile");
+            } else if (onBorder) {
+                Parser::addError(diag, line, column(starts[1]),
+                "SPAWN must not be on the border");
+            }
         }
 
-        bool onBorder = (x == 0) || (y == 0) ||
-        (x == (int)MAP_WIDTH - 1) || (y == (int)MAP_HEIGHT - 1);
-
         if(t.getType() == _TileType::GATE_NEXT ||
         t.getType() == _TileType::GATE_PREV){
-            if(onBorder == false){
-                containsGate = true;
-            } else {
-                setErr(err, errCap, 
-                "Gate tiles must not be placed on the map border.");
-                in.close();
-                return false;    
+            if (onBorder) {
+                Parser::addError(diag, line, column(starts[1]),
+                "gate tiles must not be placed on the map border");
+                continue;
             }
+            containsGate = true;
         }
+
+        outMap.set(x, y, t);
     }
 
     // check for spawn (and block invalid files)
-    if (spawnCount != 1) {
-        setErr(err, errCap, 
-        "CSV must contain exactly one SPAWN tile.");
-        in.close();
-        return false;
+    if (spawnCount == 0) {
+        Parser::addError(diag, 0, 0, "the level must contain a SPAWN tile");
     }
 
     if (containsGate == false){
-        setErr(err, errCap, 
-        "CSV must contain at least a gate tile.");
-        in.close();
-        return false;        
+        Parser::addError(diag, 0, 0,
+        "the level must contain at least a gate tile");
     }
 
-    if (spawnX <= 0 || spawnY <= 0 ||
-        spawnX >= (int)MAP_WIDTH - 1 || 
-        spawnY >= (int)MAP_HEIGHT - 1) {
-        setErr(err, errCap, "SPAWN must not be on the border.");
-        in.close();
+    if (diag->total > 0){
         return false;
     }
 
     // solid wall protection (we don't want an OutOfBoundException)
-    for (unsigned short x = 0; x < MAP_WIDTH; x++) {
+    for (unsigned short x = 0; x < width; x++) {
         outMap.set(x, 0, _Tile(_TileType::SOLID));
-        outMap.set(x, MAP_HEIGHT - 1, _Tile(_TileType::SOLID));
-    } for (unsigned short y = 0; y < MAP_HEIGHT; y++) {
+        outMap.set(x, height - 1, _Tile(_TileType::SOLID));
+    } for (unsigned short y = 0; y < height; y++) {
         outMap.set(0, y, _Tile(_TileType::SOLID));
-        outMap.set(MAP_WIDTH - 1, y, _Tile(_TileType::SOLID));
+        outMap.set(width - 1, y, _Tile(_TileType::SOLID));
     }
 
-    in.close();
-
     return true;
 }
@@ -20,7 +20,7 @@
 #ifndef PARSER_HPP
 #define PARSER_HPP
 
-#include <fstream>
+#include <cstddef>
 #include "maps.hpp"
 
 /**
@@ -29,10 +29,40 @@
  * the input format is a csv-like text file with fields separated by ';'
  * each valid row describes one tile to place in the map grid
  *
- * the function writes a short error message in err when it fails
+ * the file is mapped in memory and read in place, without copying
+ * lines or fields, every problem is reported with its line and column
  */
 class Parser {
+    // reports its header errors with addError
+    friend class BonusPack;
+
 public:
+    /**
+     * @brief a problem found in the file
+     *
+     * line and column start from 1, line 0 means the whole level
+     * (a missing SPAWN or gate)
+     */
+    struct Error {
+        int line;
+        int column;
+        const char* message; // a static string
+    };
+
+    /**
+     * @brief errors kept by Diagnostics, the others are only counted
+     */
+    static const int MAX_ERRORS = 16;
+
+    /**
+     * @brief every error of a parse, in file order
+     */
+    struct Diagnostics {
+        Parser::Error errors[Parser::MAX_ERRORS];
+        int count; // stored in errors
+        int total; // all of them, stored or not
+    };
+
     /**
      * @brief load a bonus file and populate outMap
      *
@@ -44,13 +74,59 @@ public:
      *
      * @param path file path to read
      * @param outMap destination map that will be filled
-     * @param err output buffer for an error message (can be null)
+     * @param err output buffer for the first error, as
+     * "line L, column C: message" (can be null)
      * @param errCap capacity of err (ignored if err is null)
      * @return true on success, false on error
      */
     static bool loadBonusFile(const char* path, Map& outMap,
     char* err, int errCap);
 
+    /**
+     * @brief same as loadBonusFile, every error goes in diag
+     *
+     * @param diag error list, can be null
+     */
+    static bool parseFile(const char* path, Map& outMap,
+    Parser::Diagnostics* diag);
+
+    /**
+     * @brief parses a bonus file already in memory
+     *
+     * data doesn't need a terminator and is never written
+     *
+     * @param data file content
+     * @param size bytes in data
+     * @param outMap destination map
+     * @param diag error list, can be null
+     */
+    static bool parseBuffer(const char* data, std::size_t size,
+    Map& outMap, Parser::Diagnostics* diag);
+
+    /**
+     * @brief parses the tiles of one level of a multi-level file
+     * (see BonusPack)
+     *
+     * the level covers width x height cells, border included, the
+     * cells outside it are SOLID
+     *
+     * @param data first line of the level, after its header
+     * @param size bytes of the level
+     * @param width level width (3 .. MAP_WIDTH)
+     * @param height level height (3 .. MAP_HEIGHT)
+     * @param firstLine line number of data in the file, for errors
+     * @param outMap destination map
+     * @param diag error list, can be null
+     */
+    static bool parseLevel(const char* data, std::size_t size,
+    unsigned short width, unsigned short height, int firstLine,
+    Map& outMap, Parser::Diagnostics* diag);
+
+    /**
+     * @brief writes "line L, column C: message" into err
+     */
+    static void formatError(const Parser::Error& e, char* err, int cap);
+
 private:
     /**
      * @brief copy an error message into the user buffer
@@ -62,20 +138,13 @@ private:
      * @param msg message to copy
      */
     static void setErr(char* err, int cap, const char* msg);
-    
+
     /**
-     * @brief parse a non-negative integer from a c string
-     *
-     * parsing is strict: it ignores leading spaces, 
-     * reads digits, then expects end of string
-     *
-     * @param s input string
-     * @param ok set to true if parsing 
-     * succeeds, false otherwise
-     * @return parsed value as int, or 0 if parsing fails
+     * @brief adds an error to diag (can be null)
      */
-    static int parseInt(const char* s, bool& ok);
+    static void addError(Parser::Diagnostics* diag, int line, int column,
+    const char* message);
 };
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file pool.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief defines a fixed capacity object pool
+ * implemented as a template
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * a pool owns N slots of raw storage, objects are built in a free slot
+ * with placement new and destroyed in place, so creating and destroying
+ * game objects never touches the heap
+ *
+ * a slot can hold any class derived from T, as long as it fits in
+ * SLOT bytes (checked at compile time); slots are SLOT bytes rounded
+ * up to the fundamental alignment, so every slot is aligned for any
+ * type that isn't over aligned
+ *
+ * the container is fully defined in the header file
+ *
+ */
+
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, unsigned int N, std::size_t SLOT = sizeof(T)>
+class pool {
+    private:
+        // distance between two slots, slot i starts at i * STRIDE
+        static constexpr std::size_t STRIDE =
+        (SLOT + alignof(std::max_align_t) - 1) /
+        alignof(std::max_align_t) * alignof(std::max_align_t);
+
+        // raw storage, one row per slot
+        alignas(std::max_align_t) unsigned char storage[N][STRIDE];
+
+        // stack of free slot indexes
+        unsigned int freeSlots[N];
+        unsigned int freeCount;
+
+        /**
+         * @brief deletes an object that doesn't belong to the pool
+         *
+         * kept out of line, once inlined next to a pooled pointer
+         * gcc reports a delete of non heap memory
+         */
+        __attribute__((noinline)) static void release(T* obj) {
+            delete obj;
+        }
+
+    public:
+        pool() : freeCount(N) {
+            // lowest slots are handed out first
+            for (unsigned int i = 0; i < N; i++) {
+                this->freeSlots[i] = N - 1 - i;
+            }
+        }
+
+        // objects point into storage, a copy would be meaningless
+        pool(const pool&) = delete;
+        pool& operator=(const pool&) = delete;
+
+        /**
+         * @brief builds a U in a free slot
+         *
+         * @return the new object, nullptr if every slot is in use
+         * (the pool never falls back to the heap on its own)
+         */
+        template <typename U, typename... Args>
+        U* create(Args&&... args) {
+            static_assert(std::is_base_of<T, U>::value,
+            "pool: U must derive from T");
+            static_assert(sizeof(U) <= SLOT,
+            "pool: U does not fit in a slot");
+            static_assert(alignof(U) <= alignof(std::max_align_t),
+            "pool: U is over aligned");
+            static_assert(STRIDE % alignof(U) == 0,
+            "pool: slots are not aligned for U");
+
+            if (this->freeCount == 0) {
+                return nullptr;
+            }
+
+            unsigned int slot = this->freeSlots[--this->freeCount];
+
+            try {
+                return new (this->storage[slot])
+                U(std::forward<Args>(args)...);
+            } catch (...) {
+                // the constructor threw, the slot is still free
+                this->freeCount++;
+                throw;
+            }
+        }
+
+        /**
+         * @brief destroys an object
+         *
+         * objects living in the pool are destroyed in place and their
+         * slot becomes free again, any other pointer is deleted, so
+         * callers can mix pooled and heap objects in the same list
+         */
+        void destroy(T* obj) {
+            if (obj == nullptr) {
+                return;
+            }
+
+            if (!this->owns(obj)) {
+                pool::release(obj);
+                return;
+            }
+
+            unsigned int slot = (unsigned int)(
+                (reinterpret_cast<unsigned char*>(obj) - &this->storage[0][0])
+                / STRIDE
+            );
+
+            obj->~T();
+            this->freeSlots[this->freeCount++] = slot;
+        }
+
+        /**
+         * @brief returns true if obj lives in this pool
+         */
+        bool owns(const T* obj) const {
+            const unsigned char* p =
+            reinterpret_cast<const unsigned char*>(obj);
+            return p >= &this->storage[0][0] &&
+            p < &this->storage[0][0] + N * STRIDE;
+        }
+
+        /**
+         * @brief returns the number of objects alive
+         */
+        unsigned int len() const {
+            return N - this->freeCount;
+        }
+
+        /**
+         * @brief returns true if every slot is in use
+         */
+        bool full() const {
+            return this->freeCount == 0;
+        }
+
+        /**
+         * @brief returns the number of slots
+         */
+        unsigned int capacity() const {
+            return N;
+        }
+};
+
+#endif
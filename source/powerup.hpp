@@ -20,6 +20,7 @@
 #define POWERUP_HPP
 
 #include "player.hpp"
+#include "pool.hpp"
 
 /**
  * @brief base class for all powerups
@@ -185,4 +186,19 @@ public:
     void apply(Player& p) override;
 };
 
+/**
+ * @brief max number of powerups on the ground of a level
+ *
+ * drops are skipped while the pool is full
+ */
+#define MAX_POWERUPS 32
+
+/**
+ * @brief storage for the powerups of a level
+ *
+ * every derived powerup has the same layout as PowerUp,
+ * so a PowerUp sized slot is enough
+ */
+typedef pool<PowerUp, MAX_POWERUPS> PowerUpPool;
+
 #endif
\ No newline at end of file
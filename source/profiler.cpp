@@ -0,0 +1,183 @@
+/**
+ * @file profiler.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief profiler.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "profiler.hpp"
+
+bool Profiler::enabled = false;
+unsigned long long Profiler::totalNs[Profiler::PHASE_COUNT] = {0};
+unsigned long long Profiler::samples[Profiler::PHASE_COUNT] = {0};
+unsigned long long Profiler::counters[Profiler::COUNTER_COUNT] = {0};
+
+unsigned long long Profiler::tickCount = 0;
+unsigned long long Profiler::tickAllocs = 0;
+unsigned long long Profiler::tickBytes = 0;
+unsigned long long Profiler::tickMaxAllocs = 0;
+AllocTracker::Stats Profiler::tickStart = {0, 0};
+
+Profiler::Scope::Scope(Profiler::Phase p) :
+phase(p), active(Profiler::enabled) {
+    if (this->active) {
+        this->start = std::chrono::steady_clock::now();
+    }
+}
+
+Profiler::Scope::~Scope() {
+    if (!this->active){
+        return;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    Profiler::add(this->phase, (unsigned long long)
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - this->start
+    ).count());
+}
+
+void Profiler::enable(bool on) {
+    Profiler::enabled = on;
+}
+
+bool Profiler::isEnabled() {
+    return Profiler::enabled;
+}
+
+void Profiler::reset() {
+    for (int i = 0; i < Profiler::PHASE_COUNT; i++) {
+        Profiler::totalNs[i] = 0;
+        Profiler::samples[i] = 0;
+    }
+
+    for (int i = 0; i < Profiler::COUNTER_COUNT; i++) {
+        Profiler::counters[i] = 0;
+    }
+
+    Profiler::tickCount = 0;
+    Profiler::tickAllocs = 0;
+    Profiler::tickBytes = 0;
+    Profiler::tickMaxAllocs = 0;
+}
+
+void Profiler::add(Profiler::Phase p, unsigned long long ns) {
+    if (p < 0 || p >= Profiler::PHASE_COUNT){
+        return;
+    }
+    Profiler::totalNs[p] += ns;
+    Profiler::samples[p]++;
+}
+
+unsigned long long Profiler::total(Profiler::Phase p) {
+    if (p < 0 || p >= Profiler::PHASE_COUNT){
+        return 0;
+    }
+    return Profiler::totalNs[p];
+}
+
+unsigned long long Profiler::count(Profiler::Phase p) {
+    if (p < 0 || p >= Profiler::PHASE_COUNT){
+        return 0;
+    }
+    return Profiler::samples[p];
+}
+
+const char* Profiler::name(Profiler::Phase p) {
+    switch (p) {
+        case Profiler::Phase::ENEMIES:
+            return "enemies";
+        case Profiler::Phase::COLLISIONS:
+            return "collisions";
+        case Profiler::Phase::BOMBS:
+            return "bombs";
+        case Profiler::Phase::POWERUPS:
+            return "powerups";
+        case Profiler::Phase::EXPLOSIONS:
+            return "explosions";
+        default:
+            return "unknown";
+    }
+}
+
+void Profiler::bump(Profiler::Counter c, unsigned long long n) {
+    if (!Profiler::enabled || c < 0 || c >= Profiler::COUNTER_COUNT){
+        return;
+    }
+    Profiler::counters[c] += n;
+}
+
+unsigned long long Profiler::counter(Profiler::Counter c) {
+    if (c < 0 || c >= Profiler::COUNTER_COUNT){
+        return 0;
+    }
+    return Profiler::counters[c];
+}
+
+const char* Profiler::name(Profiler::Counter c) {
+    switch (c) {
+        case Profiler::Counter::RENDER_CALLS:
+            return "render_calls";
+        case Profiler::Counter::RENDER_CELLS:
+            return "render_cells";
+        case Profiler::Counter::RENDER_BYTES:
+            return "render_bytes";
+        case Profiler::Counter::FRAMES_PRESENTED:
+            return "frames_presented";
+        case Profiler::Counter::FRAMES_DROPPED:
+            return "frames_dropped";
+        case Profiler::Counter::RECORD_FRAMES:
+            return "record_frames";
+        case Profiler::Counter::RECORD_DROPPED:
+            return "record_dropped";
+        case Profiler::Counter::INPUT_EVENTS:
+            return "input_events";
+        case Profiler::Counter::INPUT_COLLAPSED:
+            return "input_collapsed";
+        default:
+            return "unknown";
+    }
+}
+
+void Profiler::beginTick() {
+    if (!Profiler::enabled){
+        return;
+    }
+    Profiler::tickStart = AllocTracker::thread();
+}
+
+void Profiler::endTick() {
+    if (!Profiler::enabled){
+        return;
+    }
+
+    AllocTracker::Stats now = AllocTracker::thread();
+    unsigned long long n = now.count - Profiler::tickStart.count;
+
+    Profiler::tickCount++;
+    Profiler::tickAllocs += n;
+    Profiler::tickBytes += now.bytes - Profiler::tickStart.bytes;
+    if (n > Profiler::tickMaxAllocs){
+        Profiler::tickMaxAllocs = n;
+    }
+}
+
+unsigned long long Profiler::ticks() {
+    return Profiler::tickCount;
+}
+
+unsigned long long Profiler::tickAllocations() {
+    return Profiler::tickAllocs;
+}
+
+unsigned long long Profiler::tickAllocatedBytes() {
+    return Profiler::tickBytes;
+}
+
+unsigned long long Profiler::maxTickAllocations() {
+    return Profiler::tickMaxAllocs;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file profiler.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief lightweight per-phase tick profiler
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the Profiler class used to measure how much
+ * time each subsystem of a game tick takes
+ *
+ * it also accounts heap allocations per tick (see AllocTracker):
+ * the game loop wraps each tick in beginTick() / endTick()
+ *
+ * the profiler is disabled by default: when disabled every
+ * measurement costs a single branch
+ *
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "alloc_tracker.hpp"
+
+#include <chrono>
+
+/**
+ * @brief static accumulator of phase timings
+ *
+ * every phase stores the total elapsed time and
+ * the number of measurements
+ *
+ * the class is static and not thread safe, it must only be used
+ * from the game loop thread
+ */
+class Profiler {
+public:
+    /**
+     * @brief measured phases
+     */
+    enum Phase {
+        ENEMIES, // enemy ai (Level::update)
+        COLLISIONS, // enemy vs player (Level::update)
+        BOMBS, // bomb timers and explosions (Level::update)
+        POWERUPS, // powerup timers and pickups (Level::update)
+        EXPLOSIONS, // explosion ttl and player timers (Level::update)
+        PHASE_COUNT // number of phases, not a phase
+    };
+
+    /**
+     * @brief event counters
+     */
+    enum Counter {
+        RENDER_CALLS, // output calls of the game screen
+        RENDER_CELLS, // cells sent to ncurses by the game screen
+        RENDER_BYTES, // bytes written by the ansi backend
+        FRAMES_PRESENTED, // frames sent to the terminal
+        FRAMES_DROPPED, // game frames skipped, terminal behind
+        RECORD_FRAMES, // frames queued by the recorder
+        RECORD_DROPPED, // frames lost by the recorder, queue full
+        INPUT_EVENTS, // keys read during gameplay
+        INPUT_COLLAPSED, // repeated keys merged into one per tick
+        COUNTER_COUNT // number of counters, not a counter
+    };
+
+    /**
+     * @brief RAII helper, measures the lifetime of the object
+     */
+    class Scope {
+        private:
+            Profiler::Phase phase;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+        public:
+            Scope(Profiler::Phase p);
+            ~Scope();
+    };
+
+private:
+    static bool enabled;
+    static unsigned long long totalNs[Profiler::PHASE_COUNT];
+    static unsigned long long samples[Profiler::PHASE_COUNT];
+    static unsigned long long counters[Profiler::COUNTER_COUNT];
+
+    // allocation accounting of the measured ticks
+    static unsigned long long tickCount;
+    static unsigned long long tickAllocs;
+    static unsigned long long tickBytes;
+    static unsigned long long tickMaxAllocs;
+    static AllocTracker::Stats tickStart;
+
+public:
+    /**
+     * @brief enables or disables measurements
+     */
+    static void enable(bool on);
+
+    /**
+     * @brief returns true if measurements are enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief clears every accumulated value
+     */
+    static void reset();
+
+    /**
+     * @brief adds a measurement to a phase
+     */
+    static void add(Profiler::Phase p, unsigned long long ns);
+
+    /**
+     * @brief returns the total time spent in a phase (ns)
+     */
+    static unsigned long long total(Profiler::Phase p);
+
+    /**
+     * @brief returns the number of measurements of a phase
+     */
+    static unsigned long long count(Profiler::Phase p);
+
+    /**
+     * @brief returns a short lowercase name for a phase
+     */
+    static const char* name(Profiler::Phase p);
+
+    /**
+     * @brief adds n to a counter
+     */
+    static void bump(Profiler::Counter c, unsigned long long n = 1);
+
+    /**
+     * @brief returns the value of a counter
+     */
+    static unsigned long long counter(Profiler::Counter c);
+
+    /**
+     * @brief returns a short lowercase name for a counter
+     */
+    static const char* name(Profiler::Counter c);
+
+    /**
+     * @brief marks the start of a game tick
+     *
+     * snapshots the allocation counters of the calling thread
+     */
+    static void beginTick();
+
+    /**
+     * @brief marks the end of a game tick
+     *
+     * adds the allocations made since beginTick()
+     */
+    static void endTick();
+
+    /**
+     * @brief returns the number of measured ticks
+     */
+    static unsigned long long ticks();
+
+    /**
+     * @brief returns the allocations made inside measured ticks
+     */
+    static unsigned long long tickAllocations();
+
+    /**
+     * @brief returns the bytes allocated inside measured ticks
+     */
+    static unsigned long long tickAllocatedBytes();
+
+    /**
+     * @brief returns the highest allocation count of a single tick
+     */
+    static unsigned long long maxTickAllocations();
+};
+
+#endif
@@ -0,0 +1,226 @@
+/**
+ * @file recorder.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief recorder.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "recorder.hpp"
+#include "profiler.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+// slots start with this capacity, a full redraw of
+// a normal terminal fits without growing
+static const unsigned int SLOT_BYTES = 8192;
+
+Recorder::Recorder() :
+head(0), tail(0), running(false), file(nullptr), encoder(-1),
+width(0), height(0), captured(0), dropped(0) {
+    for (int i = 0; i < Recorder::QUEUE_SLOTS; i++) {
+        this->slots[i].kind = 'o';
+        this->slots[i].time = 0.0;
+        this->slots[i].data = nullptr;
+        this->slots[i].len = 0;
+        this->slots[i].cap = 0;
+    }
+    this->encoder.setColors(true);
+}
+
+Recorder::~Recorder() {
+    this->close();
+    for (int i = 0; i < Recorder::QUEUE_SLOTS; i++) {
+        delete[] this->slots[i].data;
+    }
+}
+
+void Recorder::setPalette(const short* fg, int count) {
+    this->encoder.setPalette(fg, count);
+}
+
+bool Recorder::isOpen() const {
+    return this->file != nullptr;
+}
+
+unsigned long long Recorder::capturedFrames() const {
+    return this->captured;
+}
+
+unsigned long long Recorder::droppedFrames() const {
+    return this->dropped;
+}
+
+void Recorder::open(const char* path, int width, int height) {
+    this->close();
+
+    this->file = fopen(path, "w");
+    if (this->file == nullptr){
+        throw Recorder::OpenException();
+    }
+
+    for (int i = 0; i < Recorder::QUEUE_SLOTS; i++) {
+        if (this->slots[i].cap < SLOT_BYTES) {
+            delete[] this->slots[i].data;
+            this->slots[i].data = new char[SLOT_BYTES];
+            this->slots[i].cap = SLOT_BYTES;
+        }
+    }
+
+    this->width = width;
+    this->height = height;
+    this->captured = 0;
+    this->dropped = 0;
+    this->head.store(0);
+    this->tail.store(0);
+    this->encoder.invalidate();
+
+    fprintf(this->file,
+    "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %ld, ",
+    width, height, (long)time(nullptr));
+
+    const char* term = getenv("TERM");
+    fputs("\"env\": {\"TERM\": \"", this->file);
+    if (term != nullptr){
+        this->writeEscaped(term, (unsigned int)strlen(term));
+    }
+    fputs("\"}, \"title\": \"bombergirl\"}\n", this->file);
+
+    this->start = std::chrono::steady_clock::now();
+    this->running.store(true);
+    this->writer = std::thread(&Recorder::run, this);
+}
+
+void Recorder::close() {
+    if (this->file == nullptr){
+        return;
+    }
+
+    this->running.store(false);
+    this->wake.notify_one();
+    if (this->writer.joinable()){
+        this->writer.join();
+    }
+
+    fclose(this->file);
+    this->file = nullptr;
+}
+
+// SECTION GAME THREAD
+
+bool Recorder::push(char kind, const char* data, unsigned int len) {
+    unsigned long h = this->head.load(std::memory_order_relaxed);
+    unsigned long t = this->tail.load(std::memory_order_acquire);
+    if (h - t >= (unsigned long)Recorder::QUEUE_SLOTS){
+        return false;
+    }
+
+    Recorder::Slot& s = this->slots[h % Recorder::QUEUE_SLOTS];
+    if (s.cap < len) {
+        // the writer is not using this slot
+        delete[] s.data;
+        s.data = new char[len];
+        s.cap = len;
+    }
+
+    memcpy(s.data, data, len);
+    s.len = len;
+    s.kind = kind;
+    s.time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - this->start
+    ).count();
+
+    this->head.store(h + 1, std::memory_order_release);
+    this->wake.notify_one();
+    return true;
+}
+
+void Recorder::capture(const FrameBuffer& fb) {
+    if (this->file == nullptr){
+        return;
+    }
+
+    if (fb.width() != this->width || fb.height() != this->height) {
+        char size[32];
+        int n = snprintf(size, sizeof(size), "%dx%d",
+        fb.width(), fb.height());
+        if (!this->push('r', size, (unsigned int)n)) {
+            // size and frame are retried with the next frame
+            this->dropped++;
+            Profiler::bump(Profiler::Counter::RECORD_DROPPED);
+            return;
+        }
+        this->width = fb.width();
+        this->height = fb.height();
+    }
+
+    this->encoder.encode(fb);
+    if (this->encoder.size() == 0){
+        return;
+    }
+
+    if (!this->push('o', this->encoder.data(), this->encoder.size())) {
+        // the recording misses this delta, the next frame is full
+        this->encoder.invalidate();
+        this->dropped++;
+        Profiler::bump(Profiler::Counter::RECORD_DROPPED);
+        return;
+    }
+
+    this->captured++;
+    Profiler::bump(Profiler::Counter::RECORD_FRAMES);
+}
+
+//!SECTION
+
+// SECTION WRITER THREAD
+
+void Recorder::run() {
+    while (true) {
+        unsigned long t = this->tail.load(std::memory_order_relaxed);
+        unsigned long h = this->head.load(std::memory_order_acquire);
+
+        if (t == h) {
+            if (!this->running.load()){
+                break;
+            }
+            // push() doesn't take the lock, a missed
+            // notification only delays the writer
+            std::unique_lock<std::mutex> lock(this->wakeLock);
+            this->wake.wait_for(lock, std::chrono::milliseconds(20));
+            continue;
+        }
+
+        this->writeEvent(this->slots[t % Recorder::QUEUE_SLOTS]);
+        this->tail.store(t + 1, std::memory_order_release);
+    }
+
+    fflush(this->file);
+}
+
+void Recorder::writeEvent(const Recorder::Slot& s) {
+    fprintf(this->file, "[%.6f, \"%c\", \"", s.time, s.kind);
+    this->writeEscaped(s.data, s.len);
+    fputs("\"]\n", this->file);
+}
+
+void Recorder::writeEscaped(const char* s, unsigned int len) {
+    for (unsigned int i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', this->file);
+            fputc(c, this->file);
+        } else if (c < 0x20 || c == 0x7f) {
+            fprintf(this->file, "\\u%04x", c);
+        } else {
+            fputc(c, this->file);
+        }
+    }
+}
+
+//!SECTION
@@ -0,0 +1,169 @@
+/**
+ * @file recorder.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief asciicast v2 session recorder
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the Recorder class, which saves every frame
+ * sent to the terminal in an asciicast v2 file (the format played
+ * by asciinema)
+ *
+ * each frame is encoded on the game thread as the ANSI difference
+ * with the previous one and queued in a bounded ring, a background
+ * thread writes the events to the file
+ *
+ * the game thread never waits for the writer: when the ring is full
+ * the frame is dropped and the next one is recorded in full
+ *
+ */
+
+#ifndef RECORDER_HPP
+#define RECORDER_HPP
+
+#include "ansi_terminal.hpp"
+#include "framebuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief frame recorder with a background writer thread
+ *
+ * capture() must always be called from the same thread
+ */
+class Recorder {
+public:
+    /**
+     * @brief number of frames the ring can hold (about 2 seconds)
+     */
+    static const int QUEUE_SLOTS = 64;
+
+    /**
+     * @brief thrown when the output file can't be created
+     */
+    class OpenException : public std::exception {
+        public:
+            const char* what() const noexcept override {
+                return "cannot create the recording file";
+            }
+    };
+
+private:
+    /**
+     * @brief a queued asciicast event
+     */
+    struct Slot {
+        char kind; // 'o' = output, 'r' = resize
+        double time; // seconds from the start of the recording
+        char* data;
+        unsigned int len, cap;
+    };
+
+    Slot slots[Recorder::QUEUE_SLOTS];
+
+    // slots are written by capture() at head and read by the
+    // writer at tail, both only grow
+    std::atomic<unsigned long> head;
+    std::atomic<unsigned long> tail;
+
+    std::atomic<bool> running;
+    std::thread writer;
+
+    // only used to sleep the writer while the ring is empty
+    std::mutex wakeLock;
+    std::condition_variable wake;
+
+    FILE* file;
+
+    // what the recording shows, used to encode deltas
+    AnsiTerminal encoder;
+    int width, height;
+
+    std::chrono::steady_clock::time_point start;
+
+    unsigned long long captured;
+    unsigned long long dropped;
+
+    /**
+     * @brief queues an event, false if the ring is full
+     */
+    bool push(char kind, const char* data, unsigned int len);
+
+    /**
+     * @brief writer thread body
+     */
+    void run();
+
+    /**
+     * @brief writes one event as a json line
+     */
+    void writeEvent(const Recorder::Slot& s);
+
+    /**
+     * @brief writes s as the content of a json string
+     */
+    void writeEscaped(const char* s, unsigned int len);
+
+public:
+    Recorder();
+
+    /**
+     * @brief closes the recording if it is open
+     */
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief sets the color pair palette (see AnsiTerminal)
+     */
+    void setPalette(const short* fg, int count);
+
+    /**
+     * @brief creates the file, writes the header and starts the writer
+     *
+     * @param width initial terminal width
+     * @param height initial terminal height
+     * @throws OpenException if the file can't be created
+     */
+    void open(const char* path, int width, int height);
+
+    /**
+     * @brief returns true between open() and close()
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief records the difference between fb and the last frame
+     *
+     * never blocks: if the writer is behind the frame is dropped
+     */
+    void capture(const FrameBuffer& fb);
+
+    /**
+     * @brief writes the queued events, stops the writer and
+     * closes the file
+     */
+    void close();
+
+    /**
+     * @brief returns the number of recorded frames
+     */
+    unsigned long long capturedFrames() const;
+
+    /**
+     * @brief returns the number of frames dropped (ring full)
+     */
+    unsigned long long droppedFrames() const;
+};
+
+#endif
@@ -10,29 +10,360 @@
  */
 
 #include "render.hpp"
+#include "ansi_terminal.hpp"
+#include "profiler.hpp"
+
+#include <cstdarg>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static bool g_colorsEnabled = false; // used for color check
 
+// foreground of every color pair (background is the terminal default)
+static const short PAIR_FG[] = {
+    -1, // pair 0, terminal default
+    COLOR_WHITE,
+    COLOR_BLUE,
+    COLOR_YELLOW,
+    COLOR_RED,
+    COLOR_GREEN,
+    COLOR_MAGENTA,
+    COLOR_CYAN,
+    COLOR_WHITE
+};
+static const int PAIR_COUNT = (int)(sizeof(PAIR_FG) / sizeof(PAIR_FG[0]));
+
+// game frame output
+static Render::Backend g_backend = Render::Backend::NCURSES;
+static AnsiTerminal g_ansi(STDOUT_FILENO);
+// true while the terminal shows a frame written by g_ansi
+static bool g_ansiOnScreen = false;
+
+// SECTION RENDER TARGET
+
+// every screen is composed in g_back, compared with g_front
+// (what the terminal currently shows) and only the cells that
+// changed are sent to the terminal
+static FrameBuffer g_front;
+static FrameBuffer g_back;
+
+// false when stdscr no longer matches g_front
+// (ncurses was used directly, or the terminal was resized)
+static bool g_frontValid = false;
+
+// the game screen refreshes g_back only inside the play area, so
+// after the area moves (or another screen was drawn) both buffers
+// need a full copy: this counts how many are left
+static int g_fullCopies = 2;
+
+// session recording, nullptr = off
+static Recorder* g_recorder = nullptr;
+
+// offscreen target set with setTarget(), nullptr = terminal
+static FrameBuffer* g_target = nullptr;
+
+// style of the next writes (colorOn/attrOn)
+static unsigned char g_penColor = 0;
+static unsigned char g_penAttr = FrameBuffer::NORMAL;
+
+static void presentFrame();
+
+/**
+ * @brief returns the buffer the screens draw into
+ */
+static FrameBuffer& surface() {
+    return g_target != nullptr ? *g_target : g_back;
+}
+
+/**
+ * @brief sizes the back buffers like the terminal
+ *
+ * a resize forces a full redraw, nothing to do with a target
+ */
+static void prepareSurface() {
+    if (g_target != nullptr){
+        return;
+    }
+
+    if (g_back.width() != COLS || g_back.height() != LINES) {
+        g_back.resize(COLS, LINES);
+        g_front.resize(COLS, LINES);
+        g_frontValid = false;
+    }
+}
+
+/**
+ * @brief starts a screen on a blank surface with the default style
+ */
+static void beginScreen() {
+    prepareSurface();
+    surface().clear();
+    if (g_target == nullptr){
+        g_fullCopies = 2;
+    }
+    g_penColor = 0;
+    g_penAttr = FrameBuffer::NORMAL;
+}
+
+/**
+ * @brief sends the screen to the terminal (if there is no target)
+ */
+static void endScreen() {
+    if (g_target == nullptr){
+        presentFrame();
+    }
+}
+
+/**
+ * @brief mvaddch() on the surface, with the pen style
+ */
+static void fbPut(int y, int x, char ch) {
+    surface().put(y, x, ch, g_penColor, g_penAttr);
+}
+
+/**
+ * @brief mvprintw() on the surface, with the pen style
+ */
+__attribute__((format(printf, 3, 4)))
+static void fbPrintf(int y, int x, const char* fmt, ...) {
+    char buf[256];
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    surface().print(y, x, buf, g_penColor, g_penAttr);
+}
+
+void Render::setRecorder(Recorder* r) {
+    g_recorder = r;
+    if (r != nullptr){
+        r->setPalette(PAIR_FG, PAIR_COUNT);
+    }
+}
+
+void Render::setTarget(FrameBuffer* fb) {
+    g_target = fb;
+}
+
+FrameBuffer* Render::target() {
+    return g_target;
+}
+
+int Render::lines() {
+    return g_target != nullptr ? g_target->height() : LINES;
+}
+
+int Render::cols() {
+    return g_target != nullptr ? g_target->width() : COLS;
+}
+
+//!SECTION
+
+void Render::setBackend(Render::Backend b) {
+    g_backend = b;
+}
+
+Render::Backend Render::backend() {
+    return g_backend;
+}
+
 bool Render::colorsEnabled() {
     return g_colorsEnabled;
 }
 
 void Render::colorOn(int pair) {
-    if (!g_colorsEnabled){
-        return;
+    // the color is always stored, the output
+    // drops it when colors are not available
+    g_penColor = (unsigned char)pair;
+}
+
+void Render::colorOff(int pair) {
+    if (g_penColor == (unsigned char)pair){
+        g_penColor = 0;
     }
+}
 
-    attron(COLOR_PAIR(pair));
+void Render::attrOn(unsigned char attr) {
+    g_penAttr = (unsigned char)(g_penAttr | attr);
 }
 
-void Render::colorOff(int pair) {
-    if (!g_colorsEnabled){
+void Render::attrOff(unsigned char attr) {
+    g_penAttr = (unsigned char)(g_penAttr & ~attr);
+}
+
+// SECTION STARTUP
+
+// fast start: no color demo, no delays, cached color probe
+static bool g_fastStart = false;
+
+// color probe results of the known terminals, in the user cache
+// directory ($XDG_CACHE_HOME, else $HOME/.cache)
+static const char* TERM_CACHE_DIR = "bombergirl";
+static const char* TERM_CACHE_FILE = "terminals.csv";
+static const int TERM_CACHE_MAX = 16;
+static const int TERM_CACHE_PATH_SIZE = 512;
+
+static std::chrono::steady_clock::time_point g_initStart;
+static long long g_startupNs = -1;
+
+/**
+ * @brief a cached color probe: TERM;colors;pairs
+ */
+struct TermCacheEntry {
+    char term[48];
+    int colors;
+    int pairs;
+};
+
+/**
+ * @brief writes the path of the cache file into out
+ *
+ * @param create if true, the directories of the path are made
+ * @return false if there is no cache directory (no HOME)
+ */
+static bool termCachePath(char* out, int cap, bool create) {
+    // relative XDG paths are invalid and ignored
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+
+    char dir[TERM_CACHE_PATH_SIZE];
+    int n = 0;
+    if (xdg != nullptr && xdg[0] == '/') {
+        n = snprintf(dir, sizeof(dir), "%s", xdg);
+    } else if (home != nullptr && home[0] != '\0') {
+        n = snprintf(dir, sizeof(dir), "%s/.cache", home);
+    } else {
+        return false;
+    }
+    if (n <= 0 || n >= (int)sizeof(dir)){
+        return false;
+    }
+
+    // an existing directory is not an error
+    if (create){
+        mkdir(dir, 0700);
+    }
+    n = snprintf(out, (std::size_t)cap, "%s/%s", dir, TERM_CACHE_DIR);
+    if (n <= 0 || n >= cap){
+        return false;
+    }
+    if (create){
+        mkdir(out, 0700);
+    }
+    n = snprintf(out, (std::size_t)cap, "%s/%s/%s", dir, TERM_CACHE_DIR,
+    TERM_CACHE_FILE);
+    return n > 0 && n < cap;
+}
+
+/**
+ * @brief reads the cache file, returns the number of entries
+ */
+static int loadTermCache(TermCacheEntry* entries) {
+    char path[TERM_CACHE_PATH_SIZE];
+    if (!termCachePath(path, sizeof(path), false)){
+        return 0;
+    }
+
+    std::ifstream in(path);
+    if (!in.is_open()){
+        return 0;
+    }
+
+    int count = 0;
+    char line[96];
+    while (count < TERM_CACHE_MAX && in.getline(line, sizeof(line))) {
+        char* sep1 = strchr(line, ';');
+        if (sep1 == nullptr){
+            continue;
+        }
+        char* sep2 = strchr(sep1 + 1, ';');
+        if (sep2 == nullptr){
+            continue;
+        }
+        *sep1 = '\0';
+        *sep2 = '\0';
+
+        TermCacheEntry& e = entries[count];
+        int n = 0;
+        for (; line[n] != '\0' && n < (int)sizeof(e.term) - 1; n++) {
+            e.term[n] = line[n];
+        }
+        e.term[n] = '\0';
+        e.colors = atoi(sep1 + 1);
+        e.pairs = atoi(sep2 + 1);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief looks up the probe of term, false if unknown
+ */
+static bool findTermCache(const char* term, int& colors, int& pairs) {
+    TermCacheEntry entries[TERM_CACHE_MAX];
+    int count = loadTermCache(entries);
+
+    for (int i = 0; i < count; i++) {
+        if (strcmp(entries[i].term, term) == 0) {
+            colors = entries[i].colors;
+            pairs = entries[i].pairs;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief adds (or replaces) the probe of term in the cache file
+ *
+ * the oldest entry is forgotten when the cache is full
+ */
+static void storeTermCache(const char* term, int colors, int pairs) {
+    TermCacheEntry entries[TERM_CACHE_MAX];
+    int count = loadTermCache(entries);
+
+    char path[TERM_CACHE_PATH_SIZE];
+    if (!termCachePath(path, sizeof(path), true)){
         return;
     }
-    attroff(COLOR_PAIR(pair));
+    std::ofstream out(path);
+    if (!out.is_open()){
+        return;
+    }
+
+    int first = count >= TERM_CACHE_MAX ? 1 : 0;
+    for (int i = first; i < count; i++) {
+        if (strcmp(entries[i].term, term) != 0) {
+            out << entries[i].term << ";" << entries[i].colors << ";"
+            << entries[i].pairs << "\n";
+        }
+    }
+    out << term << ";" << colors << ";" << pairs << "\n";
 }
 
+void Render::setFastStart(bool on) {
+    g_fastStart = on;
+}
+
+long long Render::startupNs() {
+    return g_startupNs;
+}
+
+//!SECTION
+
 void Render::init() {
+    g_initStart = std::chrono::steady_clock::now();
+    g_startupNs = -1;
+
     initscr();
 
     cbreak();
@@ -42,42 +373,70 @@ void Render::init() {
 
     nodelay(stdscr, TRUE);
 
-    // that's a real color check, if false the game will run without colors
-    if (!has_colors()) {
+    // the color probe depends only on the terminfo entry
+    const char* term = getenv("TERM");
+    if (term == nullptr || term[0] == '\0' || strchr(term, ';') != nullptr
+    || strlen(term) >= sizeof(TermCacheEntry::term)){
+        term = "unknown";
+    }
+
+    int colors = 0;
+    int pairs = 0;
+    if (!g_fastStart || !findTermCache(term, colors, pairs)) {
+        // that's a real color check, if false the game will run without colors
+        if (has_colors()) {
+            start_color();
+            colors = COLORS;
+            pairs = COLOR_PAIRS;
+        }
+        if (g_fastStart){
+            storeTermCache(term, colors, pairs);
+        }
+    } else if (colors > 0) {
+        start_color();
+    }
+
+    if (colors == 0) {
         g_colorsEnabled = false;
-        clear();
-        mvprintw(0, 0, "WARNING: Terminal does NOT support colors.");
-        refresh();
-        napms(2000);
+        if (!g_fastStart) {
+            clear();
+            mvprintw(0, 0, "WARNING: Terminal does NOT support colors.");
+            refresh();
+            napms(2000);
+        }
         return;
     }
 
-    start_color();
     use_default_colors();
 
-    if (COLORS < 8 || COLOR_PAIRS < 8) {
+    if (colors < 8 || pairs < 8) {
         g_colorsEnabled = false;
-        clear();
-        mvprintw(0, 0,
-            "WARNING: Not enough colors (%d) or pairs (%d).",
-            COLORS, COLOR_PAIRS);
-        refresh();
-        napms(2000);
+        if (!g_fastStart) {
+            clear();
+            mvprintw(0, 0,
+                "WARNING: Not enough colors (%d) or pairs (%d).",
+                colors, pairs);
+            refresh();
+            napms(2000);
+        }
         return;
     }
 
     // setting ncurses colors
-    init_pair(1,COLOR_WHITE,-1);
-    init_pair(2,COLOR_BLUE, -1);
-    init_pair(3,COLOR_YELLOW, -1);
-    init_pair(4,COLOR_RED, -1);
-    init_pair(5, COLOR_GREEN,-1);
-    init_pair(6,COLOR_MAGENTA,-1);
-    init_pair(7,COLOR_CYAN,-1);
-    init_pair(8,  COLOR_WHITE,-1);
+    for (int i = 1; i < PAIR_COUNT; i++) {
+        init_pair(i, PAIR_FG[i], -1);
+    }
+
+    // same palette for the ansi backend
+    g_ansi.setPalette(PAIR_FG, PAIR_COUNT);
+    g_ansi.setColors(true);
 
     g_colorsEnabled = true;
 
+    if (g_fastStart){
+        return;
+    }
+
     clear();
 
     int y = LINES / 2 - 4;
@@ -112,34 +471,34 @@ void Render::init() {
 
 
 void Render::drawAsciiBox(int y, int x, int h, int w) {
-    mvaddch(y,     x,     '+');
-    mvaddch(y,     x+w-1, '+');
-    mvaddch(y+h-1, x,     '+');
-    mvaddch(y+h-1, x+w-1, '+');
+    fbPut(y,     x,     '+');
+    fbPut(y,     x+w-1, '+');
+    fbPut(y+h-1, x,     '+');
+    fbPut(y+h-1, x+w-1, '+');
     
     for (int i = 1; i < w-1; i++) {
-        mvaddch(y,     x+i, '-');
-        mvaddch(y+h-1, x+i, '-');
+        fbPut(y,     x+i, '-');
+        fbPut(y+h-1, x+i, '-');
     }
 
     for (int i = 1; i < h-1; i++) {
-        mvaddch(y+i, x,     '|');
-        mvaddch(y+i, x+w-1, '|');
+        fbPut(y+i, x,     '|');
+        fbPut(y+i, x+w-1, '|');
     }
 }
 
 void Render::drawTitle(int y, int x) {
     //ASCII ART
     //i know it looks like gibberish
-    mvprintw(y+0, x, " ____   ___  __  __ ____  _____ ____"
+    fbPrintf(y+0, x, " ____   ___  __  __ ____  _____ ____"
     "   ____ ___ ____  _     ");
-    mvprintw(y+1, x, "| __ ) / _ \\|  \\/  | __ )| ____|"
+    fbPrintf(y+1, x, "| __ ) / _ \\|  \\/  | __ )| ____|"
     "  _ \\ / ___|_ _|  _ \\| |    ");
-    mvprintw(y+2, x, "|  _ \\| | | | |\\/| |  _ \\|  _| "
+    fbPrintf(y+2, x, "|  _ \\| | | | |\\/| |  _ \\|  _| "
     "| |_) | |  _ | || |_) | |    ");
-    mvprintw(y+3, x, "| |_) | |_| | |  | | |_) | |___|  "
+    fbPrintf(y+3, x, "| |_) | |_| | |  | | |_) | |___|  "
     "_ <| |_| || ||  _ <| |___ ");
-    mvprintw(y+4, x, "|____/ \\___/|_|  |_|____/|_____|_| "
+    fbPrintf(y+4, x, "|____/ \\___/|_|  |_|____/|_____|_| "
     "\\_\\\\____|___|_| \\_\\_____|");
 }
 
@@ -175,9 +534,9 @@ void Render::drawSparkle(int y, int x, int h, int w, int step) {
     }
 
     Render::colorOn(3);
-    attron(A_BOLD);
-    mvaddch(sy, sx, '*');
-    attroff(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
+    fbPut(sy, sx, '*');
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(3);
 }
 
@@ -202,12 +561,12 @@ int Render::centerX(int boxX, int boxW, int textW) {
 
 void Render::drawHearts(int y, int xLeft, int xRight, bool strong) {
     if (strong){
-        attron(A_BOLD);
+        Render::attrOn(FrameBuffer::BOLD);
     }
-    mvprintw(y, xLeft,  "<3");
-    mvprintw(y, xRight, "<3");
+    fbPrintf(y, xLeft,  "<3");
+    fbPrintf(y, xRight, "<3");
     if (strong){
-        attroff(A_BOLD);
+        Render::attrOff(FrameBuffer::BOLD);
     }
 }
 
@@ -220,19 +579,19 @@ void Render::safePrint(int y, int x, const char* s) {
     if (y < 0){
         y = 0;
     }
-    if (y >= LINES){
-        y = LINES - 1;
+    if (y >= Render::lines()){
+        y = Render::lines() - 1;
     }
 
     // and x
     if (x < 0){
         x = 0;
     }
-    if (x >= COLS){
-        x = COLS - 1;
+    if (x >= Render::cols()){
+        x = Render::cols() - 1;
     }
 
-    mvprintw(y, x, "%s", s);
+    fbPrintf(y, x, "%s", s);
 }
 
 void Render::safeCenterPrint(int y, const char* s) {
@@ -240,28 +599,28 @@ void Render::safeCenterPrint(int y, const char* s) {
         return;
     }
 
-    if (y < 0 || y >= LINES){
+    if (y < 0 || y >= Render::lines()){
         return;
     }
 
     int len = Render::strLen(s);
-    int x = (COLS - len) / 2;
+    int x = (Render::cols() - len) / 2;
 
     if (x < 0){
         x = 0;
     }
 
-    int maxLen = COLS - x;
+    int maxLen = Render::cols() - x;
     if (maxLen <= 0){
         return;
     }
 
     for (int i = 0; i < len && i < maxLen; i++) {
-        mvaddch(y, x + i, s[i]);
+        fbPut(y, x + i, s[i]);
     }
 }
 
-void Render::drawMenu(int selectedItem) {
+void Render::drawMenu(int selectedItem, int animStep) {
 
     const int ITEM_COUNT = 3;
     const char* items[ITEM_COUNT] = {
@@ -270,33 +629,29 @@ void Render::drawMenu(int selectedItem) {
         "EXIT"
     };
 
-    static int animStep = 0;
-    static int dots = 0;
+    int dots = 0;
 
-    erase();
+    beginScreen();
 
     // display error, menu does not fit in the terminal
-    if (LINES < 22 || COLS < 74) {
-        erase();
-
+    if (Render::lines() < 22 || Render::cols() < 74) {
         Render::colorOn(4); // red error
-        attron(A_BOLD);
+        Render::attrOn(FrameBuffer::BOLD);
 
-        Render::safeCenterPrint(LINES / 2, 
+        Render::safeCenterPrint(Render::lines() / 2, 
         "PLEASE RESIZE THE TERMINAL");
 
-        attroff(A_BOLD);
+        Render::attrOff(FrameBuffer::BOLD);
         Render::colorOff(4);
 
-        refresh();
-        animStep++;
+        endScreen();
         return;
     }
 
     int boxW = 74;
     int boxH = 20;
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     Render::colorOn(6);
     drawAsciiBox(startY, startX, boxH, boxW);
@@ -317,11 +672,11 @@ void Render::drawMenu(int selectedItem) {
 
     Render::colorOn(6);
     if (breathe){
-        attron(A_BOLD);
+        Render::attrOn(FrameBuffer::BOLD);
     }
     drawTitle(titleY, titleX);
     if (breathe){
-        attroff(A_BOLD);
+        Render::attrOff(FrameBuffer::BOLD);
     }
     Render::colorOff(6);
 
@@ -358,9 +713,9 @@ void Render::drawMenu(int selectedItem) {
 
     // hint text
     Render::colorOn(7);
-    mvprintw(startY + 7, startX + 22, 
+    fbPrintf(startY + 7, startX + 22, 
     "Use ARROWS + ENTER to select%s", dotStr);
-    mvprintw(startY + 8, startX + 22, 
+    fbPrintf(startY + 8, startX + 22, 
     "Press Q to quit");
     Render::colorOff(7);
 
@@ -372,60 +727,32 @@ void Render::drawMenu(int selectedItem) {
         if (i == selectedItem) {
             Render::colorOn(6); 
 
-            attron(A_REVERSE | A_BOLD);
-            mvprintw(row, startX + 24, " > %-18s < ", items[i]);
-            attroff(A_REVERSE | A_BOLD);
+            Render::attrOn(FrameBuffer::REVERSE | FrameBuffer::BOLD);
+            fbPrintf(row, startX + 24, " > %-18s < ", items[i]);
+            Render::attrOff(FrameBuffer::REVERSE | FrameBuffer::BOLD);
             Render::colorOff(6);
 
         } else {
             Render::colorOn(1);
 
-            mvprintw(row, startX + 24, "   %-18s   ", items[i]);
+            fbPrintf(row, startX + 24, "   %-18s   ", items[i]);
             Render::colorOff(1);
         }
     }
     Render::colorOn(7);
-    mvprintw(startY + boxH - 2, startX + 2,
+    fbPrintf(startY + boxH - 2, startX + 2,
     "[UP/DOWN] Move   [ENTER] Select   [Q] Quit   [C] Credits");
     Render::colorOff(7);
 
-    refresh();
-
-    animStep++;
+    endScreen();
 }
 
 
 void Render::shutdown() {
-    endwin();
-}
-
-void Render::drawHudInBox( int boxX, int boxY, int boxW,
-int levelIndex, int timeLeft, int score, int lives) {
-    char buf[128];
-    
-    sprintf(buf,
-        "LEVEL %d   TIME %d   SCORE %d   LIVES %d",
-        levelIndex + 1,
-        timeLeft,
-        score,
-        lives
-    );
-
-    int len = Render::strLen(buf);
-
-    int x = boxX + (boxW - len) / 2;
-
-    if (x < boxX + 1){
-        x = boxX + 1;
+    if (g_ansiOnScreen){
+        g_ansi.release();
     }
-
-    int y = boxY + 1;
-
-    Render::colorOn(7);
-    attron(A_BOLD);
-    mvprintw(y, x, "%s", buf);
-    attroff(A_BOLD);
-    Render::colorOff(7);
+    endwin();
 }
 
 static int blinkPeriodFromInvuln(int invulnLeft, int invulnTotal) {
@@ -487,16 +814,368 @@ static int enemyColor(Enemy::Kind k){
     return 1; // same as powerup
 }
 
+// SECTION GAME FRAME
+
+static chtype cellAttrs(const FrameBuffer::Cell& c) {
+    chtype a = A_NORMAL;
+    if (g_colorsEnabled && c.color != 0){
+        a |= COLOR_PAIR(c.color);
+    }
+    if (c.attr & FrameBuffer::BOLD){
+        a |= A_BOLD;
+    }
+    if (c.attr & FrameBuffer::DIM){
+        a |= A_DIM;
+    }
+    if (c.attr & FrameBuffer::REVERSE){
+        a |= A_REVERSE;
+    }
+    return a;
+}
+
+static bool sameStyle(const FrameBuffer::Cell& a,
+const FrameBuffer::Cell& b) {
+    return a.color == b.color && a.attr == b.attr;
+}
+
+/**
+ * @brief sends len cells of row y, starting at x, with one
+ * attribute switch and one mvaddnstr
+ *
+ * every cell of the run must share color and attributes
+ */
+static void emitRun(const FrameBuffer& fb, int y, int x, int len) {
+    char buf[256];
+
+    attrset(cellAttrs(fb.at(y, x)));
+
+    // wider runs (very large terminals) are split
+    for (int done = 0; done < len; ) {
+        int n = len - done;
+        if (n > (int)sizeof(buf)){
+            n = (int)sizeof(buf);
+        }
+        for (int i = 0; i < n; i++) {
+            buf[i] = fb.at(y, x + done + i).ch;
+        }
+        mvaddnstr(y, x + done, buf, n);
+        done += n;
+
+        Profiler::bump(Profiler::Counter::RENDER_CALLS);
+    }
+
+    Profiler::bump(Profiler::Counter::RENDER_CELLS, (unsigned long long)len);
+}
+
+// a run may carry up to this many unchanged cells of the same
+// style, rewriting them is cheaper than another call
+static const int RUN_GAP = 3;
+
+/**
+ * @brief sends g_back to the terminal and makes it the front buffer
+ *
+ * after an invalidation the screen is erased and every non blank
+ * cell is sent, otherwise only the cells that differ from g_front
+ *
+ * cells are grouped in runs of the same style on each row
+ */
+static void emitFrame() {
+    if (g_backend == Render::Backend::ANSI) {
+        // one write() per frame, ncurses is not involved
+        long n = g_ansi.present(g_back);
+        g_ansiOnScreen = true;
+        g_front.swap(g_back);
+
+        Profiler::bump(Profiler::Counter::RENDER_CALLS);
+        if (n > 0){
+            Profiler::bump(Profiler::Counter::RENDER_BYTES,
+            (unsigned long long)n);
+        }
+        return;
+    }
+
+    const int h = g_back.height();
+    const int w = g_back.width();
+
+    const bool full = !g_frontValid;
+    const FrameBuffer::Cell blank = FrameBuffer::blank();
+
+    if (full){
+        erase();
+    }
+
+    for (int y = 0; y < h; y++) {
+        int x = 0;
+        while (x < w) {
+            const FrameBuffer::Cell& c = g_back.at(y, x);
+            bool dirty = full ? c != blank : c != g_front.at(y, x);
+            if (!dirty) {
+                x++;
+                continue;
+            }
+
+            // extend the run while the style holds and
+            // the gap of clean cells stays short
+            int last = x;
+            for (int nx = x + 1; nx < w && nx - last <= RUN_GAP; nx++) {
+                const FrameBuffer::Cell& n = g_back.at(y, nx);
+                if (!sameStyle(c, n)){
+                    break;
+                }
+                if (full ? n != blank : n != g_front.at(y, nx)){
+                    last = nx;
+                }
+            }
+
+            emitRun(g_back, y, x, last - x + 1);
+            x = last + 1;
+        }
+    }
+
+    attrset(A_NORMAL);
+    g_frontValid = true;
+
+    g_front.swap(g_back);
+    refresh();
+}
+
+// SECTION BACKPRESSURE
+
+// over a slow link (ssh) the terminal can't take 30 frames per
+// second: writes block and the output queue grows, so game frames
+// are dropped while the simulation keeps ticking
+
+// bytes waiting in the tty output queue above which frames are dropped
+static const int BACKLOG_LIMIT = 2048;
+
+// smoothed present time above which frames are dropped
+// (a frame lasts about 33 ms)
+static const long long SLOW_PRESENT_NS = 20000000LL;
+
+// at least one frame out of this many is sent anyway
+static const int MAX_DROPS_IN_A_ROW = 8;
+
+static long long g_presentNs = 0;
+static int g_dropsInARow = 0;
+
+/**
+ * @brief returns the bytes not yet sent by the tty, 0 if unknown
+ */
+static int pendingOutput() {
+#ifdef TIOCOUTQ
+    int n = 0;
+    if (ioctl(STDOUT_FILENO, TIOCOUTQ, &n) == 0){
+        return n;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief true if the next game frame should be skipped
+ */
+static bool shouldDropFrame() {
+    if (g_dropsInARow >= MAX_DROPS_IN_A_ROW){
+        return false;
+    }
+
+    if (pendingOutput() <= BACKLOG_LIMIT && g_presentNs <= SLOW_PRESENT_NS){
+        return false;
+    }
+
+    // nothing is written while dropping, the
+    // old latency must fade out to resume
+    g_presentNs /= 2;
+    g_dropsInARow++;
+    Profiler::bump(Profiler::Counter::FRAMES_DROPPED);
+    return true;
+}
+
+/**
+ * @brief sends g_back and measures how long the terminal took
+ */
+static void presentFrame() {
+    std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+    emitFrame();
+
+    long long ns = (long long)std::chrono::duration_cast<
+    std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (g_startupNs < 0) {
+        g_startupNs = (long long)std::chrono::duration_cast<
+        std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+        - g_initStart).count();
+    }
+
+    g_presentNs = (g_presentNs * 3 + ns) / 4;
+    g_dropsInARow = 0;
+    Profiler::bump(Profiler::Counter::FRAMES_PRESENTED);
+
+    // g_front is the frame just sent
+    if (g_recorder != nullptr){
+        g_recorder->capture(g_front);
+    }
+}
+
+//!SECTION
+
+void Render::invalidate() {
+    g_frontValid = false;
+    g_ansi.invalidate();
+
+    // ncurses doesn't know what the ansi backend wrote,
+    // its next refresh must repaint everything
+    if (g_ansiOnScreen) {
+        g_ansi.release();
+        clearok(curscr, TRUE);
+        g_ansiOnScreen = false;
+    }
+}
+
+static char cellGlyph(Board::CellType c, unsigned char& color) {
+    switch (c) {
+        case Board::CellType::EMPTY:
+            color = 1;
+            return ' ';
+        case Board::CellType::WALL_SOLID:
+            color = 2;
+            return '#';
+        case Board::CellType::WALL_DESTRUCTIBLE:
+            color = 3;
+            return '+';
+        case Board::CellType::EXPLOSION:
+            color = 4;
+            return '*';
+        case Board::CellType::GATE_NEXT:
+            color = 7;
+            return '>';
+        case Board::CellType::GATE_PREV:
+            color = 7;
+            return '<';
+        default:
+            color = 1;
+            return '?';
+    }
+}
+
+// the game screen has two layers: the background (hud box and
+// labels, pink frame, floor and solid walls) is built once per
+// board layout and terminal size, the dynamic layer (hud values,
+// destructible walls, explosions, gates and entities) is drawn
+// on top of it every frame
+static FrameBuffer g_background;
+
+// layout revision g_background was built for, 0 = none
+static unsigned long g_bgRevision = 0;
+
+// hud fields: the labels belong to the background,
+// the values are written in fixed width slots after them
+static const char* HUD_LABELS[4] = {"LEVEL", "TIME", "SCORE", "LIVES"};
+static const int HUD_SLOTS[4] = {2, 4, 7, 2};
+static const int HUD_GAP = 3;
+
+/**
+ * @brief returns the width of the hud line (labels, slots and gaps)
+ */
+static int hudWidth() {
+    int w = 0;
+    for (int i = 0; i < 4; i++) {
+        w += (int)Render::strLen(HUD_LABELS[i]) + 1 + HUD_SLOTS[i];
+    }
+    return w + HUD_GAP * 3;
+}
+
+/**
+ * @brief returns the column of the value slot of field i
+ */
+static int hudSlotX(int hudX, int i) {
+    int x = hudX;
+    for (int f = 0; f < i; f++) {
+        x += (int)Render::strLen(HUD_LABELS[f]) + 1 + HUD_SLOTS[f] + HUD_GAP;
+    }
+    return x + (int)Render::strLen(HUD_LABELS[i]) + 1;
+}
+
+/**
+ * @brief a hud value, formatted only when it changes
+ */
+struct HudField {
+    int value;
+    bool valid;
+    char text[16]; // padded to the slot width
+    int pending; // screen buffers still showing an older text
+};
+
+static HudField g_hud[4];
+
+// notice under the board frame, "" if none
+static char g_notice[192];
+
+/**
+ * @brief stores a new value for field i, formats it if it changed
+ */
+static void setHudField(int i, int value) {
+    HudField& f = g_hud[i];
+    if (f.valid && f.value == value){
+        return;
+    }
+
+    snprintf(f.text, sizeof(f.text), "%-*d", HUD_SLOTS[i], value);
+    f.value = value;
+    f.valid = true;
+    // g_back and g_front both need the new text
+    f.pending = 2;
+}
+
+/**
+ * @brief writes the hud values that fb doesn't show yet
+ *
+ * @param all true when fb holds no value at all (fresh copy
+ * of the background, or an offscreen target)
+ */
+static void drawHudFields(FrameBuffer& fb, int y, int hudX, bool all) {
+    for (int i = 0; i < 4; i++) {
+        HudField& f = g_hud[i];
+        if (!all && f.pending == 0){
+            continue;
+        }
+
+        fb.print(y, hudSlotX(hudX, i), f.text, 7, FrameBuffer::BOLD);
+        if (f.pending > 0 && g_target == nullptr){
+            f.pending--;
+        }
+    }
+}
+
+/**
+ * @brief true for the cells stored in the background layer
+ */
+static bool isStaticCell(Board::CellType c) {
+    return c == Board::CellType::EMPTY || c == Board::CellType::WALL_SOLID;
+}
+
 void Render::draw(const Board& board, const Player& player,
 const list<Enemy*>& enemies, const list<Bomb*>& bombs,
 int timeLeft, int score, int lives, int levelIndex,
-const list<PowerUp*>& powerUps) {
+const list<PowerUp*>& powerUps, const char* notice) {
     // static variable used for 
     // invulnerability blink
     static int animFrame = 0;
     animFrame++;
 
-    erase();
+    // the terminal is behind, g_front stays as it is
+    // and the next frame sends both changes
+    if (g_target == nullptr && shouldDropFrame()){
+        return;
+    }
+
+    prepareSurface();
+
+    FrameBuffer& fb = surface();
+    const int screenH = Render::lines();
+    const int screenW = Render::cols();
 
     const int tileW = 2;
     const int hudH = 3;
@@ -516,109 +1195,125 @@ const list<PowerUp*>& powerUps) {
     const int totalW = frameW + padX * 2;
 
     // terminal size error
-    if (LINES < totalH + 2 || COLS < totalW + 2) {
-        Render::colorOn(4);
-        attron(A_BOLD);
+    if (screenH < totalH + 2 || screenW < totalW + 2) {
+        fb.clear();
+        g_fullCopies = 2;
+
         const char* msg = "RESIZE TERMINAL";
-        mvprintw(
-            LINES / 2, 
-            (COLS - (int)Render::strLen(msg)) / 2,
-            "%s", 
-            msg
+        fb.print(
+            screenH / 2, 
+            (screenW - (int)Render::strLen(msg)) / 2,
+            msg,
+            4,
+            FrameBuffer::BOLD
         );
-        attroff(A_BOLD);
-        Render::colorOff(4);
-        refresh();
+        endScreen();
         return;
     }
 
-    int startY = (LINES - totalH) / 2;
-    int startX = (COLS  - totalW) / 2;
+    int startY = (screenH - totalH) / 2;
+    int startX = (screenW  - totalW) / 2;
 
     int hudBoxW = frameW;
     int hudBoxH = 3;
     int hudBoxX = startX + padX; 
     int hudBoxY = startY;
-
-    Render::colorOn(7);
-    Render::drawAsciiBox(hudBoxY, hudBoxX, hudBoxH, hudBoxW);
-    Render::colorOff(7);
-
-    drawHudInBox(
-        hudBoxX, hudBoxY, hudBoxW,
-        levelIndex,
-        timeLeft,
-        score,
-        lives
-    );
+    int hudX = Render::centerX(hudBoxX, hudBoxW, hudWidth());
 
     int frameY = startY + hudH + padY;
     int frameX = startX + padX;
 
-
-    Render::colorOn(6);
-    //this is the pink box
-    Render::drawAsciiBox(frameY, frameX, frameH, frameW);
-    Render::colorOff(6);
-
     int boardY = frameY + 1;
     int boardX = frameX + 1;
 
-    //printing the board
-    for (int y = 0; y < bh; y++) {
-        for (int x = 0; x < bw; x++) {
-            Board::CellType c = board.getCell(
-                (unsigned short)x, (unsigned short)y
-            );
-
-            char ch1 = ' ';
-            char ch2 = ' ';
-            int color = 1;
+    // rebuild the background when the walls or the terminal changed
+    if (g_bgRevision != board.getLayoutRevision() ||
+    g_background.width() != screenW || g_background.height() != screenH) {
+        g_background.resize(screenW, screenH);
 
-            switch (c) {
-                case Board::CellType::EMPTY:
-                    ch1 = ' '; ch2 = ' ';
-                    color = 1;
-                    break;
+        g_background.box(hudBoxY, hudBoxX, hudBoxH, hudBoxW, 7);
+        for (int i = 0; i < 4; i++) {
+            g_background.print(hudBoxY + 1,
+            hudSlotX(hudX, i) - (int)Render::strLen(HUD_LABELS[i]) - 1,
+            HUD_LABELS[i], 7, FrameBuffer::BOLD);
+        }
 
-                case Board::CellType::WALL_SOLID:
-                    ch1 = '#'; ch2 = '#';
-                    color = 2;
-                    break;
+        //this is the pink box
+        g_background.box(frameY, frameX, frameH, frameW, 6);
+
+        for (int y = 0; y < bh; y++) {
+            for (int x = 0; x < bw; x++) {
+                Board::CellType c = board.getCell(
+                    (unsigned short)x, (unsigned short)y
+                );
+                if (!isStaticCell(c)){
+                    c = Board::CellType::EMPTY;
+                }
+                unsigned char color = 1;
+                char ch = cellGlyph(c, color);
+
+                g_background.put(boardY + y, boardX + x * tileW, ch, color);
+                g_background.put(boardY + y, boardX + x * tileW + 1,
+                ch, color);
+            }
+        }
 
-                case Board::CellType::WALL_DESTRUCTIBLE:
-                    ch1 = '+'; ch2 = '+';
-                    color = 3;
-                    break;
+        g_bgRevision = board.getLayoutRevision();
+        g_fullCopies = 2;
+    }
 
-                case Board::CellType::EXPLOSION:
-                    ch1 = '*'; ch2 = '*';
-                    color = 4;
-                    break;
+    // the notice is outside the frame, both screen buffers
+    // take it (or lose it) with a full copy
+    if (notice == nullptr){
+        notice = "";
+    }
+    if (strcmp(notice, g_notice) != 0) {
+        snprintf(g_notice, sizeof(g_notice), "%s", notice);
+        g_fullCopies = 2;
+    }
 
-                case Board::CellType::GATE_NEXT:
-                    ch1 = '>'; ch2 = '>';
-                    color = 7;
-                    break;
+    // everything outside the board frame (hud included) is already
+    // in place unless the layout just changed (an offscreen target
+    // is never trusted)
+    bool fullCopy = g_target != nullptr || g_fullCopies > 0;
+    if (fullCopy) {
+        fb.copyFrom(g_background);
+        if (g_target == nullptr){
+            g_fullCopies--;
+        }
+    } else {
+        fb.blit(g_background, frameY, frameX, frameH, frameW);
+    }
+    if (fullCopy && g_notice[0] != '\0') {
+        int x = (screenW - (int)Render::strLen(g_notice)) / 2;
+        fb.print(frameY + frameH, x < 0 ? 0 : x, g_notice, 4,
+        FrameBuffer::BOLD);
+    }
 
-                case Board::CellType::GATE_PREV:
-                    ch1 = '<'; ch2 = '<';
-                    color = 7;
-                    break;
+    // hud values, written only when they change
+    setHudField(0, levelIndex + 1);
+    setHudField(1, timeLeft);
+    setHudField(2, score);
+    setHudField(3, lives);
+    drawHudFields(fb, hudBoxY + 1, hudX, fullCopy);
 
-                default:
-                    ch1 = '?'; ch2 = '?';
-                    color = 1;
-                    break;
+    // dynamic cells of the board, the others come from the background
+    for (int y = 0; y < bh; y++) {
+        for (int x = 0; x < bw; x++) {
+            Board::CellType c = board.getCell(
+                (unsigned short)x, (unsigned short)y
+            );
+            if (isStaticCell(c)){
+                continue;
             }
+            unsigned char color = 1;
+            char ch = cellGlyph(c, color);
 
             int sx = boardX + x * tileW;
             int sy = boardY + y;
 
-            Render::colorOn(color);
-            mvaddch(sy, sx, ch1);
-            mvaddch(sy, sx + 1, ch2);
-            Render::colorOff(color);
+            fb.put(sy, sx, ch, color);
+            fb.put(sy, sx + 1, ch, color);
         }
     }
 
@@ -627,7 +1322,8 @@ const list<PowerUp*>& powerUps) {
      * 
      */
     auto drawEntity = [&](unsigned short ex, 
-    unsigned short ey, char c, int colorPair) {
+    unsigned short ey, char c, int colorPair,
+    unsigned char attr = FrameBuffer::NORMAL) {
         if (ex >= (unsigned short)bw || 
         ey >= (unsigned short)bh){
             return;
@@ -635,10 +1331,8 @@ const list<PowerUp*>& powerUps) {
         int sx = boardX + (int)ex * tileW;
         int sy = boardY + (int)ey;
 
-        Render::colorOn(colorPair);
-        mvaddch(sy, sx, c);
-        mvaddch(sy, sx + 1, ' '); 
-        Render::colorOff(colorPair);
+        fb.put(sy, sx, c, (unsigned char)colorPair, attr);
+        fb.put(sy, sx + 1, ' ', (unsigned char)colorPair, attr);
     };
 
     //show bombs
@@ -668,28 +1362,25 @@ const list<PowerUp*>& powerUps) {
         player.getInvulnTotal());
         bool phase = blinkPhase(animFrame, period);
 
-        if (phase) attron(A_BOLD);
-        else       attron(A_DIM);
-
-        drawEntity(player.getX(), player.getY(), '@', 5);
-
-        if (phase) attroff(A_BOLD);
-        else       attroff(A_DIM);
+        drawEntity(player.getX(), player.getY(), '@', 5,
+        phase ? FrameBuffer::BOLD : FrameBuffer::DIM);
     } else {
         drawEntity(player.getX(), player.getY(), '@', 5);
     }
 
-    refresh();
+    endScreen();
 }
 
+//!SECTION
+
 void Render::drawNameEntry(const char name[4], int selectedIndex,
 int score, bool victory) {
-    erase();
+    beginScreen();
 
     const int boxW = 60;
     const int boxH = 16;
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
     if (startY < 0) startY = 0;
     if (startX < 0) startX = 0;
 
@@ -698,24 +1389,24 @@ int score, bool victory) {
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
     if (victory) {
-        mvprintw(startY + 1, startX + 18, "YOU WIN!");
+        fbPrintf(startY + 1, startX + 18, "YOU WIN!");
     } else {
-        mvprintw(startY + 1, startX + 16, "GAME OVER");
+        fbPrintf(startY + 1, startX + 16, "GAME OVER");
     }
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
-    mvprintw(startY + 3, startX + 18, "SCORE: %d", score);
+    fbPrintf(startY + 3, startX + 18, "SCORE: %d", score);
     Render::colorOff(7);
 
-    mvprintw(startY + 5, startX + 8, 
+    fbPrintf(startY + 5, startX + 8, 
     "ENTER YOUR INITIALS");
-    mvprintw(startY + 6, startX + 8, 
+    fbPrintf(startY + 6, startX + 8, 
     "UP/DOWN change letter  LEFT/RIGHT move");
-    mvprintw(startY + 7, startX + 8,
+    fbPrintf(startY + 7, startX + 8,
      "ENTER confirm          Q cancel");
 
     int lettersY = startY + 10;
@@ -724,22 +1415,42 @@ int score, bool victory) {
     for (int i = 0; i < 3; i++) {
         if (i == selectedIndex) {
             Render::colorOn(6);
-            attron(A_REVERSE | A_BOLD);
-            mvaddch(lettersY, lettersX + i * 4, name[i]);
-            attroff(A_REVERSE | A_BOLD);
+            Render::attrOn(FrameBuffer::REVERSE | FrameBuffer::BOLD);
+            fbPut(lettersY, lettersX + i * 4, name[i]);
+            Render::attrOff(FrameBuffer::REVERSE | FrameBuffer::BOLD);
             Render::colorOff(6);
         } else {
             Render::colorOn(6);
-            attron(A_BOLD);
-            mvaddch(lettersY, lettersX + i * 4, name[i]);
-            attroff(A_BOLD);
+            Render::attrOn(FrameBuffer::BOLD);
+            fbPut(lettersY, lettersX + i * 4, name[i]);
+            Render::attrOff(FrameBuffer::BOLD);
             Render::colorOff(6);
         }
 
-        mvprintw(lettersY + 1, lettersX + i * 4 - 1, "___");
+        fbPrintf(lettersY + 1, lettersX + i * 4 - 1, "___");
     }
 
-    refresh();
+    endScreen();
+}
+
+void Render::drawEndScreen(bool victory) {
+    beginScreen();
+
+    if (victory) {
+        fbPrintf(Render::lines()/2, (Render::cols() - 8)/2, "YOU WIN!");
+        fbPrintf(Render::lines()/2 + 2, (Render::cols() - 28)/2,
+        "Press ENTER for menu");
+        fbPrintf(Render::lines()/2 + 3, (Render::cols() - 16)/2,
+        "Press Q to quit");
+    } else {
+        fbPrintf(Render::lines()/2, (Render::cols() - 9)/2, "GAME OVER");
+        fbPrintf(Render::lines()/2 + 2, (Render::cols() - 24)/2,
+        "Press ENTER for menu");
+        fbPrintf(Render::lines()/2 + 3, (Render::cols() - 12)/2,
+        "Press Q to quit");
+    }
+
+    endScreen();
 }
 
 void Render::handleResize() {
@@ -765,28 +1476,29 @@ void Render::handleResize() {
 
     clearok(stdscr, TRUE);
     erase();
+    Render::invalidate();
     refresh();
 
     flushinp(); // flush resize spam
 }
 
 void Render::drawLeaderboardEmpty() {
-    erase();
+    beginScreen();
 
     const int boxW = 60;
     const int boxH = 10;
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     Render::colorOn(6);
     Render::drawAsciiBox(startY, startX, boxH, boxW);
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
     Render::safeCenterPrint(startY + 2, 
     "LEADERBOARD");
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
@@ -796,51 +1508,51 @@ void Render::drawLeaderboardEmpty() {
     "Press ENTER to go back.");
     Render::colorOff(7);
 
-    refresh();
+    endScreen();
 }
 
 void Render::drawLeaderboardAskCount(int maxEntries, int current) {
-    erase();
+    beginScreen();
 
     const int boxW = 60;
     const int boxH = 12;
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     Render::colorOn(6);
     Render::drawAsciiBox(startY, startX, boxH, boxW);
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
     Render::safeCenterPrint(startY + 2, "LEADERBOARD");
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
     Render::safeCenterPrint(startY + 5, 
     "How many entries to show?");
     Render::safeCenterPrint(startY + 6, 
-    "Use UP/DOWN, ENTER to confirm");
+    "UP/DOWN, PGUP/PGDN x10, ENTER to confirm");
     Render::colorOff(7);
 
     Render::colorOn(6);
-    attron(A_BOLD);
-    mvprintw( 
+    Render::attrOn(FrameBuffer::BOLD);
+    fbPrintf( 
         startY + 8, 
         startX + (boxW - 10) / 2, 
         "[ %2d / %2d ]", 
         current, 
         maxEntries
     );
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
     Render::safeCenterPrint(startY + boxH - 2, "ESC/Q to go back");
     Render::colorOff(7);
 
-    refresh();
+    endScreen();
 }
 
 static void appendNumber(char* out, int& idx, int v) {
@@ -862,10 +1574,103 @@ static void appendNumber(char* out, int& idx, int v) {
     }
 }
 
+// SECTION RETAINED LEADERBOARD
+
+static const int LEADERBOARD_PAGE_SIZE = 5;
+
+/**
+ * @brief a formatted leaderboard row, kept until the entry
+ * shown in that row changes
+ */
+struct LeaderboardRow {
+    bool valid;
+    int rank;
+    int score;
+    char name[3];
+    char text[32];
+};
+
+static LeaderboardRow g_lbRows[LEADERBOARD_PAGE_SIZE];
+
+// footer text and the values it was built from
+static char g_lbFooter[64];
+static int g_lbFooterKey[4] = {-1, -1, -1, -1};
+
+/**
+ * @brief returns the text of row i, formatted only if it changed
+ */
+static const char* leaderboardRow(int i, int rank,
+const Leaderboard::ScoreEntry& e) {
+    LeaderboardRow& r = g_lbRows[i];
+    if (r.valid && r.rank == rank && r.score == e.score &&
+    r.name[0] == e.name[0] && r.name[1] == e.name[1] &&
+    r.name[2] == e.name[2]) {
+        return r.text;
+    }
+
+    snprintf(r.text, sizeof(r.text), "%2d  %c%c%c    %d",
+    rank, e.name[0], e.name[1], e.name[2], e.score);
+    r.valid = true;
+    r.rank = rank;
+    r.score = e.score;
+    r.name[0] = e.name[0];
+    r.name[1] = e.name[1];
+    r.name[2] = e.name[2];
+    return r.text;
+}
+
+/**
+ * @brief returns "Showing X/Y  Page a/b", built only if it changed
+ */
+static const char* leaderboardFooter(int maxToShow, int total,
+int page, int pages) {
+    if (g_lbFooterKey[0] == maxToShow && g_lbFooterKey[1] == total &&
+    g_lbFooterKey[2] == page && g_lbFooterKey[3] == pages) {
+        return g_lbFooter;
+    }
+
+    char* footer = g_lbFooter;
+    int idx = 0;
+
+    footer[idx++] = 'S'; 
+    footer[idx++] = 'h'; 
+    footer[idx++] = 'o';
+    footer[idx++] = 'w'; 
+    footer[idx++] = 'i'; 
+    footer[idx++] = 'n';
+    footer[idx++] = 'g'; 
+    footer[idx++] = ' ';
+
+    appendNumber(footer, idx, maxToShow);
+    footer[idx++] = '/';
+    appendNumber(footer, idx, total);
+
+    footer[idx++] = ' ';
+    footer[idx++] = ' ';
+    footer[idx++] = 'P'; 
+    footer[idx++] = 'a'; 
+    footer[idx++] = 'g';
+    footer[idx++] = 'e'; 
+    footer[idx++] = ' ';
+
+    appendNumber(footer, idx, page + 1);
+    footer[idx++] = '/';
+    appendNumber(footer, idx, pages);
+
+    footer[idx] = '\0';
+
+    g_lbFooterKey[0] = maxToShow;
+    g_lbFooterKey[1] = total;
+    g_lbFooterKey[2] = page;
+    g_lbFooterKey[3] = pages;
+    return g_lbFooter;
+}
+
+//!SECTION
 
 void Render::drawLeaderboard(const Leaderboard& lb,
  int maxToShow, int page) {
-    erase();
+    beginScreen();
 
     int total = lb.size();
     if (total <= 0) {
@@ -881,7 +1686,7 @@ void Render::drawLeaderboard(const Leaderboard& lb,
         maxToShow = total;
     }
 
-    const int PAGE_SIZE = 5;
+    const int PAGE_SIZE = LEADERBOARD_PAGE_SIZE;
 
     int pages = (maxToShow + PAGE_SIZE - 1) / PAGE_SIZE;
 
@@ -904,44 +1709,37 @@ void Render::drawLeaderboard(const Leaderboard& lb,
         endIndex = maxToShow;
     }
 
-    int n = endIndex - startIndex;
+    // the page only, whatever the size of the table
+    Leaderboard::ScoreEntry shown[LEADERBOARD_PAGE_SIZE];
+    int n = lb.range(startIndex, endIndex - startIndex, shown);
 
     const int boxW = 60;
     int boxH = 9 + n;
 
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     Render::colorOn(6);
     Render::drawAsciiBox(startY, startX, boxH, boxW);
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
     Render::safeCenterPrint(startY + 1, "LEADERBOARD");
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
-    mvprintw(startY + 3, startX + 4, "#   NAME   SCORE");
+    fbPrintf(startY + 3, startX + 4, "#   NAME   SCORE");
     Render::colorOff(7);
 
     int rowY = startY + 5;
     for (int i = 0; i < n; i++) {
-        const Leaderboard::ScoreEntry& e = lb.at(startIndex + i);
+        const Leaderboard::ScoreEntry& e = shown[i];
         int rank = startIndex + i + 1;
 
         Render::colorOn(1);
-        mvprintw(
-            rowY + i, 
-            startX + 4, 
-            "%2d  %c%c%c    %d",
-            rank,
-            e.name[0], 
-            e.name[1], 
-            e.name[2],
-            e.score
-        );
+        fbPrintf(rowY + i, startX + 4, "%s", leaderboardRow(i, rank, e));
         Render::colorOff(1);
     }
 
@@ -950,65 +1748,36 @@ void Render::drawLeaderboard(const Leaderboard& lb,
     Render::colorOn(7);
 
     // footer: "Showing X/Y   Page a/b"
-
-    char footer[64];
-    int idx = 0;
-
-    footer[idx++] = 'S'; 
-    footer[idx++] = 'h'; 
-    footer[idx++] = 'o';
-    footer[idx++] = 'w'; 
-    footer[idx++] = 'i'; 
-    footer[idx++] = 'n';
-    footer[idx++] = 'g'; 
-    footer[idx++] = ' ';
-
-    appendNumber(footer, idx, maxToShow);
-    footer[idx++] = '/';
-    appendNumber(footer, idx, total);
-
-    footer[idx++] = ' ';
-    footer[idx++] = ' ';
-    footer[idx++] = 'P'; 
-    footer[idx++] = 'a'; 
-    footer[idx++] = 'g';
-    footer[idx++] = 'e'; 
-    footer[idx++] = ' ';
-
-    appendNumber(footer, idx, page + 1);
-    footer[idx++] = '/';
-    appendNumber(footer, idx, pages);
-
-    footer[idx] = '\0';
+    const char* footer = leaderboardFooter(maxToShow, total, page, pages);
 
     Render::safeCenterPrint(lastRowY + 2, footer);
     Render::safeCenterPrint(
         lastRowY + 3,
-        "LEFT/RIGHT page  |  ENTER/Q back"
+        "LEFT/RIGHT/HOME/END page  |  ENTER/Q back"
     );
 
     Render::colorOff(7);
 
-    refresh();
+    endScreen();
 }
 
 void Render::drawCredits() {
-    erase();
+    beginScreen();
 
     const int boxW = 70;
     const int boxH = 14;
 
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     Render::colorOn(6);
     Render::drawAsciiBox(startY, startX, boxH, boxW);
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
     Render::safeCenterPrint(startY + 1, "CREDITS");
-    attroff(A_BOLD);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     Render::colorOn(7);
@@ -1023,19 +1792,19 @@ void Render::drawCredits() {
     int colID   = startX + boxW - 18;
 
     Render::colorOn(7);
-    mvprintw(tableY, colName, "NAME                     SURNAME");
-    mvprintw(tableY, colID,   "ID");
+    fbPrintf(tableY, colName, "NAME                     SURNAME");
+    fbPrintf(tableY, colID,   "ID");
     Render::colorOff(7);
 
     Render::colorOn(1);
-    mvprintw(tableY + 2, colName, "Martina Lisa Saffo        Ramponi");
-    mvprintw(tableY + 2, colID,   "0001220008");
+    fbPrintf(tableY + 2, colName, "Martina Lisa Saffo        Ramponi");
+    fbPrintf(tableY + 2, colID,   "0001220008");
 
-    mvprintw(tableY + 3, colName, "Martina                   Nazzareni ");
-    mvprintw(tableY + 3, colID,   "0001223089");
+    fbPrintf(tableY + 3, colName, "Martina                   Nazzareni ");
+    fbPrintf(tableY + 3, colID,   "0001223089");
 
-    mvprintw(tableY + 4, colName, "---------                 ---------  ");
-    mvprintw(tableY + 4, colID,   "---------");
+    fbPrintf(tableY + 4, colName, "---------                 ---------  ");
+    fbPrintf(tableY + 4, colID,   "---------");
     Render::colorOff(1);
 
     Render::colorOn(7);
@@ -1045,17 +1814,17 @@ void Render::drawCredits() {
     );
     Render::colorOff(7);
 
-    refresh();
+    endScreen();
 }
 
-void Render::drawBonusError(const char* msg){
-    erase();
+void Render::drawBonusError(const char* msg, const char* title){
+    beginScreen();
 
     const int boxW = 74;
     const int boxH = 14;
 
-    int startY = (LINES - boxH) / 2;
-    int startX = (COLS  - boxW) / 2;
+    int startY = (Render::lines() - boxH) / 2;
+    int startX = (Render::cols()  - boxW) / 2;
 
     if (startY < 0){
         startY = 0;
@@ -1070,9 +1839,9 @@ void Render::drawBonusError(const char* msg){
     Render::colorOff(6);
 
     Render::colorOn(6);
-    attron(A_BOLD);
-    Render::safeCenterPrint(startY + 2, "BONUS MODE ERROR");
-    attroff(A_BOLD);
+    Render::attrOn(FrameBuffer::BOLD);
+    Render::safeCenterPrint(startY + 2, title);
+    Render::attrOff(FrameBuffer::BOLD);
     Render::colorOff(6);
 
     
@@ -1141,6 +1910,6 @@ void Render::drawBonusError(const char* msg){
     "Press ENTER / Q to go back");
     Render::colorOff(7);
 
-    refresh();
+    endScreen();
 
 }
@@ -25,6 +25,8 @@
 #include "enemies.hpp"
 #include "bomb.hpp"
 #include "list.hpp"
+#include "framebuffer.hpp"
+#include "recorder.hpp"
 
 /**
  * @brief static rendering interface for the game
@@ -47,6 +49,74 @@ public:
         SCREEN_GAMEOVER
     };
 
+    /**
+     * @brief terminal output of the screens
+     */
+    enum Backend {
+        NCURSES, // ncurses calls and refresh()
+        ANSI // raw escape sequences, one write() per frame
+    };
+
+    /**
+     * @brief selects the terminal output of every screen
+     */
+    static void setBackend(Render::Backend b);
+
+    /**
+     * @brief returns the terminal output of the screens
+     */
+    static Render::Backend backend();
+
+    /**
+     * @brief redirects every draw function to an offscreen buffer
+     *
+     * while a target is set the screens are composed in fb, with
+     * the size of fb, and nothing is sent to the terminal (ncurses
+     * doesn't even need to be initialized), nullptr goes back to
+     * the terminal
+     *
+     * the target must outlive its use, it is not owned
+     */
+    static void setTarget(FrameBuffer* fb);
+
+    /**
+     * @brief returns the offscreen target, nullptr for the terminal
+     */
+    static FrameBuffer* target();
+
+    /**
+     * @brief returns the height of the current output
+     * (the target, or the terminal)
+     */
+    static int lines();
+
+    /**
+     * @brief returns the width of the current output
+     * (the target, or the terminal)
+     */
+    static int cols();
+
+    /**
+     * @brief records every frame sent to the terminal in r
+     *
+     * nullptr stops recording, r is not owned (and not closed)
+     */
+    static void setRecorder(Recorder* r);
+
+    /**
+     * @brief skips the color test screen and every startup delay
+     *
+     * the color probe is read from (or saved to) a cache file keyed
+     * by TERM, must be called before init()
+     */
+    static void setFastStart(bool on);
+
+    /**
+     * @brief returns the time from init() to the first frame sent
+     * to the terminal (ns), -1 before it
+     */
+    static long long startupNs();
+
     /**
      * @brief initializes ncurses and rendering settings
      */
@@ -61,6 +131,11 @@ public:
      * @brief draws the main game screen
      *
      * renders the board, player, enemies, bombs, powerups and hud
+     *
+     * the static part (frames, hud labels, floor, solid walls) is
+     * cached and copied, only the rest is drawn every frame
+     *
+     * @param notice a line shown under the board, nullptr for none
      */
     static void draw(
         const Board& board,
@@ -71,15 +146,26 @@ public:
         int score,
         int lives,
         int levelIndex,
-        const list<PowerUp*>& powerUps
+        const list<PowerUp*>& powerUps,
+        const char* notice = nullptr
     );
 
+    /**
+     * @brief forces the next screen to be redrawn in full
+     *
+     * must be called whenever ncurses writes to the terminal
+     * outside this class
+     */
+    static void invalidate();
+
     /**
      * @brief draws the main menu screen
      *
      * highlights the currently selected menu item
+     *
+     * @param animStep animation step (sparkle, title, dots)
      */
-    static void drawMenu(int selectedItem);
+    static void drawMenu(int selectedItem, int animStep);
 
     /**
      * @brief draws a simple ascii box
@@ -119,22 +205,31 @@ public:
     static bool colorsEnabled();
 
     /**
-     * @brief enables a color pair if colors
-     * are available
+     * @brief uses a color pair for the next writes
+     *
+     * the pair is dropped on output if colors are not available
      */
     static void colorOn(int pair);
 
     /**
-     * @brief disables a color pair if colors
-     * are available
+     * @brief disables a color pair if it is the current one
      */
     static void colorOff(int pair);
+
+    /**
+     * @brief adds FrameBuffer::Attr flags to the next writes
+     */
+    static void attrOn(unsigned char attr);
+
+    /**
+     * @brief removes FrameBuffer::Attr flags from the next writes
+     */
+    static void attrOff(unsigned char attr);
     
     /**
-     * @brief draws the hud inside a boxed area
+     * @brief draws the game over (or victory) screen
      */
-    static void drawHudInBox( int boxX, int boxY, int boxW,
-    int levelIndex, int timeLeft, int score, int lives);
+    static void drawEndScreen(bool victory);
 
     /**
      * @brief draws the name entry screen
@@ -179,9 +274,11 @@ public:
     static void drawCredits();
     
     /**
-     * @brief draws an error screen for bonus mode
+     * @brief draws an error screen for bonus mode, or for a level
+     * that can't be built
      */
-    static void drawBonusError(const char* msg);
+    static void drawBonusError(const char* msg,
+    const char* title = "BONUS MODE ERROR");
 };
 
 #endif
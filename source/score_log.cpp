@@ -0,0 +1,431 @@
+/**
+ * @file score_log.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief score_log.hpp implementation
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "score_log.hpp"
+#include "leaderboard.hpp"
+#include "random.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char LOG_MAGIC[4] = {'B', 'G', 'S', 'L'};
+static const std::uint32_t LOG_VERSION = 1;
+
+// records read at once by replay()
+static const int REPLAY_BATCH = 256;
+
+static_assert(sizeof(ScoreLog::Header) == 16, "score log header layout");
+static_assert(sizeof(ScoreLog::Record) == 16, "score log record layout");
+
+/**
+ * @brief FNV-1a of the fields before check
+ */
+static std::uint32_t checksum(const ScoreLog::Record& r) {
+    const unsigned char* p = (const unsigned char*)&r;
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < offsetof(ScoreLog::Record, check); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+ScoreLog::ScoreLog() :
+fd(-1), sync(ScoreLog::Sync::ALWAYS), dirty(false), stopping(false) {
+    this->snapshotPath[0] = '\0';
+    this->logPath[0] = '\0';
+    this->mark.valid = false;
+}
+
+ScoreLog::~ScoreLog() {
+    this->close();
+}
+
+bool ScoreLog::logPathOf(const char* path, char* out, int cap) {
+    int n = snprintf(out, (std::size_t)cap, "%s.log", path);
+    return n > 0 && n < cap;
+}
+
+bool ScoreLog::writeHeader(int fd) {
+    ScoreLog::Header h;
+    memcpy(h.magic, LOG_MAGIC, sizeof(h.magic));
+    h.version = LOG_VERSION;
+
+    // one more than the log being replaced, so two compactions in
+    // the same second never reuse a generation; a new log starts
+    // from a random one (0 is the mark of no log)
+    ScoreLog::Header old;
+    if (ScoreLog::readHeader(fd, old)) {
+        h.generation = old.generation + 1;
+    } else {
+        h.generation = Random::newSeed();
+    }
+    if (h.generation == 0){
+        h.generation = 1;
+    }
+
+    // an empty file: the header is also its end
+    return ftruncate(fd, 0) == 0 &&
+    pwrite(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h) &&
+    fdatasync(fd) == 0;
+}
+
+bool ScoreLog::readHeader(int fd, ScoreLog::Header& h) {
+    if (pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)){
+        return false;
+    }
+    return memcmp(h.magic, LOG_MAGIC, sizeof(h.magic)) == 0 &&
+    h.version == LOG_VERSION;
+}
+
+std::uint32_t ScoreLog::recordsOf(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)){
+        return 0;
+    }
+
+    // a torn record at the end is not counted
+    return (std::uint32_t)(
+        ((std::size_t)st.st_size - sizeof(Header)) / sizeof(Record)
+    );
+}
+
+std::uint32_t ScoreLog::replay(int fd, std::uint32_t from,
+Leaderboard& into) {
+    const std::uint32_t total = ScoreLog::recordsOf(fd);
+
+    ScoreLog::Record batch[REPLAY_BATCH];
+    for (std::uint32_t i = from; i < total; ) {
+        std::uint32_t n = total - i;
+        if (n > (std::uint32_t)REPLAY_BATCH){
+            n = REPLAY_BATCH;
+        }
+
+        const off_t at = (off_t)(sizeof(Header) + (std::size_t)i *
+        sizeof(Record));
+        const ssize_t got = pread(fd, batch, n * sizeof(Record), at);
+        if (got <= 0){
+            break;
+        }
+        n = (std::uint32_t)((std::size_t)got / sizeof(Record));
+
+        for (std::uint32_t k = 0; k < n; k++) {
+            const ScoreLog::Record& r = batch[k];
+            if (r.check != checksum(r) || r.score < 0){
+                continue;
+            }
+            char name[4] = {r.name[0], r.name[1], r.name[2], '\0'};
+            into.add(name, (int)r.score);
+        }
+        i += n;
+    }
+
+    return total;
+}
+
+bool ScoreLog::open(const char* path, ScoreLog::Sync sync) {
+    this->close();
+
+    if ((int)strlen(path) >= ScoreLog::PATH_SIZE ||
+    !ScoreLog::logPathOf(path, this->logPath, ScoreLog::PATH_SIZE)){
+        return false;
+    }
+    strcpy(this->snapshotPath, path);
+
+    this->fd = ::open(this->logPath, O_RDWR | O_APPEND | O_CREAT |
+    O_CLOEXEC, 0644);
+    if (this->fd < 0){
+        return false;
+    }
+
+    // a new log gets its header, a torn record is cut so the next
+    // appends stay aligned
+    bool ok = flock(this->fd, LOCK_EX) == 0;
+    if (ok) {
+        ScoreLog::Header h;
+        struct stat st;
+        if (!ScoreLog::readHeader(this->fd, h)) {
+            ok = ScoreLog::writeHeader(this->fd);
+        } else if (fstat(this->fd, &st) == 0) {
+            const std::size_t body = (std::size_t)st.st_size - sizeof(h);
+            const std::size_t torn = body % sizeof(Record);
+            if (torn != 0){
+                ok = ftruncate(this->fd, st.st_size - (off_t)torn) == 0;
+            }
+        }
+        flock(this->fd, LOCK_UN);
+    }
+    if (!ok) {
+        ::close(this->fd);
+        this->fd = -1;
+        return false;
+    }
+
+    this->sync = sync;
+    this->mark.valid = false;
+    this->dirty = false;
+    this->stopping = false;
+    this->compactor = std::thread(&ScoreLog::run, this);
+    return true;
+}
+
+void ScoreLog::close() {
+    if (this->compactor.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(this->mutex);
+            this->stopping = true;
+        }
+        this->wake.notify_one();
+        this->compactor.join();
+    }
+
+    if (this->fd < 0){
+        return;
+    }
+
+    if (this->dirty.exchange(false)){
+        fdatasync(this->fd);
+    }
+    this->compact();
+
+    ::close(this->fd);
+    this->fd = -1;
+}
+
+bool ScoreLog::isOpen() const {
+    return this->fd >= 0;
+}
+
+bool ScoreLog::append(const char name[4], int score) {
+    if (this->fd < 0){
+        return false;
+    }
+
+    ScoreLog::Record r;
+    r.name[0] = name[0];
+    r.name[1] = name[1];
+    r.name[2] = name[2];
+    r.name[3] = '\0';
+    r.score = score;
+    r.time = (std::uint32_t)time(nullptr);
+    r.check = checksum(r);
+
+    // O_APPEND: a record is never split by another writer
+    if (flock(this->fd, LOCK_SH) != 0){
+        return false;
+    }
+    bool ok = write(this->fd, &r, sizeof(r)) == (ssize_t)sizeof(r);
+    if (ok && this->sync == ScoreLog::Sync::ALWAYS){
+        ok = fdatasync(this->fd) == 0;
+    }
+    flock(this->fd, LOCK_UN);
+
+    if (this->sync == ScoreLog::Sync::PERIODIC){
+        this->dirty = true;
+    }
+    return ok;
+}
+
+bool ScoreLog::compact() {
+    // a description of its own, flock doesn't exclude a
+    // description from itself
+    int lfd = ::open(this->logPath, O_RDWR | O_CLOEXEC);
+    if (lfd < 0){
+        return false;
+    }
+    if (flock(lfd, LOCK_EX) != 0) {
+        ::close(lfd);
+        return false;
+    }
+
+    bool ok = false;
+    ScoreLog::Header h;
+    if (ScoreLog::readHeader(lfd, h)) {
+        std::uint64_t generation = 0;
+        std::uint32_t from = 0;
+        Leaderboard::loadMark(this->snapshotPath, &generation, &from);
+        if (generation != h.generation){
+            from = 0;
+        }
+
+        // nothing new: the snapshot is not read at all
+        ok = ScoreLog::recordsOf(lfd) <= from;
+        if (!ok) {
+            Leaderboard board;
+            board.loadSnapshot(this->snapshotPath, &generation, &from);
+            if (generation != h.generation){
+                from = 0;
+            }
+
+            const std::uint32_t total = ScoreLog::replay(lfd, from,
+            board);
+            // the snapshot holds the whole log, a crash before the
+            // new header replays nothing
+            ok = board.saveSnapshot(this->snapshotPath, h.generation,
+            total) && ScoreLog::writeHeader(lfd);
+        }
+    }
+
+    flock(lfd, LOCK_UN);
+    ::close(lfd);
+    return ok;
+}
+
+void ScoreLog::run() {
+    std::unique_lock<std::mutex> guard(this->mutex);
+    int seconds = 0;
+
+    while (!this->stopping) {
+        this->wake.wait_for(guard, std::chrono::seconds(1));
+        if (this->stopping){
+            break;
+        }
+        guard.unlock();
+
+        if (this->dirty.exchange(false)){
+            fdatasync(this->fd);
+        }
+        if (++seconds >= ScoreLog::COMPACT_SECONDS) {
+            seconds = 0;
+            this->compact();
+        }
+
+        guard.lock();
+    }
+}
+
+void ScoreLog::stamp(const char* path, ScoreLog::Mark& mark) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        mark.device = 0;
+        mark.inode = 0;
+        mark.size = 0;
+        mark.mtime = 0;
+        return;
+    }
+    // a compaction renames a new file over it
+    mark.device = (std::uint64_t)st.st_dev;
+    mark.inode = (std::uint64_t)st.st_ino;
+    mark.size = (std::uint64_t)st.st_size;
+    mark.mtime = (std::uint64_t)st.st_mtim.tv_sec * 1000000000ull +
+    (std::uint64_t)st.st_mtim.tv_nsec;
+}
+
+bool ScoreLog::readLocked(const char* path, int lfd, Leaderboard& board,
+ScoreLog::Mark& mark) {
+    mark.valid = false;
+    ScoreLog::stamp(path, mark);
+
+    std::uint64_t generation = 0;
+    std::uint32_t from = 0;
+    bool ok = board.loadSnapshot(path, &generation, &from);
+
+    ScoreLog::Header h;
+    if (lfd >= 0 && ScoreLog::readHeader(lfd, h)) {
+        if (generation != h.generation){
+            from = 0;
+        }
+        mark.records = ScoreLog::replay(lfd, from, board);
+        mark.generation = h.generation;
+        mark.valid = true;
+        ok = true;
+    }
+
+    return ok;
+}
+
+bool ScoreLog::reload(Leaderboard& board) {
+    int lfd = ::open(this->logPath, O_RDONLY | O_CLOEXEC);
+
+    // no compaction between the two reads
+    if (lfd >= 0 && flock(lfd, LOCK_SH) != 0) {
+        ::close(lfd);
+        lfd = -1;
+    }
+
+    ScoreLog::Mark now;
+    ScoreLog::stamp(this->snapshotPath, now);
+
+    ScoreLog::Header h;
+    bool ok;
+    if (lfd >= 0 && this->mark.valid && ScoreLog::readHeader(lfd, h) &&
+    h.generation == this->mark.generation &&
+    now.device == this->mark.device && now.inode == this->mark.inode &&
+    now.size == this->mark.size && now.mtime == this->mark.mtime) {
+        // the tail only
+        this->mark.records = ScoreLog::replay(lfd, this->mark.records,
+        board);
+        ok = true;
+    } else {
+        ok = ScoreLog::readLocked(this->snapshotPath, lfd, board,
+        this->mark);
+    }
+
+    if (lfd >= 0) {
+        flock(lfd, LOCK_UN);
+        ::close(lfd);
+    }
+    return ok;
+}
+
+bool ScoreLog::read(const char* path, Leaderboard& board) {
+    char log[ScoreLog::PATH_SIZE];
+    int lfd = -1;
+    if (ScoreLog::logPathOf(path, log, sizeof(log))){
+        lfd = ::open(log, O_RDONLY | O_CLOEXEC);
+    }
+
+    // no compaction between the two reads
+    if (lfd >= 0 && flock(lfd, LOCK_SH) != 0) {
+        ::close(lfd);
+        lfd = -1;
+    }
+
+    ScoreLog::Mark unused;
+    bool ok = ScoreLog::readLocked(path, lfd, board, unused);
+
+    if (lfd >= 0) {
+        flock(lfd, LOCK_UN);
+        ::close(lfd);
+    }
+    return ok;
+}
+
+bool ScoreLog::replace(const char* path, const Leaderboard& board) {
+    char log[ScoreLog::PATH_SIZE];
+    int lfd = -1;
+    if (ScoreLog::logPathOf(path, log, sizeof(log))){
+        lfd = ::open(log, O_RDWR | O_CLOEXEC);
+    }
+    if (lfd >= 0 && flock(lfd, LOCK_EX) != 0) {
+        ::close(lfd);
+        lfd = -1;
+    }
+
+    bool ok = board.saveSnapshot(path, 0, 0);
+
+    if (lfd >= 0) {
+        // the board replaces the log content too
+        if (ok){
+            ok = ScoreLog::writeHeader(lfd);
+        }
+        flock(lfd, LOCK_UN);
+        ::close(lfd);
+    }
+
+    return ok;
+}
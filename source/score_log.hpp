@@ -0,0 +1,240 @@
+/**
+ * @file score_log.hpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief append-only score log with background compaction
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file defines the ScoreLog class, which stores the leaderboard
+ * as a sorted snapshot (scores.csv) plus a log of the scores added
+ * since (scores.csv.log)
+ *
+ * a new score is a single fixed-size record appended to the log, so
+ * many games can share one score file: appends take a shared flock,
+ * a compaction takes an exclusive one
+ *
+ * the compaction merges the log into a new snapshot (written to a
+ * temporary file and renamed over the old one) and then starts a
+ * new log; the snapshot names the log generation and the records it
+ * already holds, so a crash between the two steps replays nothing
+ * twice
+ *
+ * recovery (Leaderboard::load) reads the snapshot, then replays the
+ * records of the log it doesn't hold; a torn record at the end of
+ * the log (a crash while writing) is ignored and cut by open()
+ *
+ */
+
+#ifndef SCORE_LOG_HPP
+#define SCORE_LOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class Leaderboard;
+
+/**
+ * @brief writer side of a shared score file
+ */
+class ScoreLog {
+public:
+    /**
+     * @brief when appended records reach the disk
+     */
+    enum Sync {
+        NEVER,    // when the system decides
+        ALWAYS,   // before append() returns
+        PERIODIC  // within a second, from the compactor thread
+    };
+
+    /**
+     * @brief seconds between two compactions
+     */
+    static const int COMPACT_SECONDS = 10;
+
+    /**
+     * @brief longest path handled, terminator included
+     */
+    static const int PATH_SIZE = 512;
+
+    /**
+     * @brief log header, at offset 0
+     */
+    struct Header {
+        char magic[4]; // "BGSL"
+        std::uint32_t version;
+        std::uint64_t generation; // changed by every compaction
+    };
+
+    /**
+     * @brief a score, appended with a single write()
+     */
+    struct Record {
+        char name[4];
+        std::int32_t score;
+        std::uint32_t time;  // seconds since the epoch
+        std::uint32_t check; // of the other fields
+    };
+
+private:
+    /**
+     * @brief what a board read of the files, so the next reload()
+     * reads only the new records
+     */
+    struct Mark {
+        bool valid;
+        // snapshot file identity, all 0 if it doesn't exist
+        std::uint64_t device;
+        std::uint64_t inode;
+        std::uint64_t size;
+        std::uint64_t mtime; // nanoseconds
+        // log generation and records read
+        std::uint64_t generation;
+        std::uint32_t records;
+    };
+
+    char snapshotPath[ScoreLog::PATH_SIZE];
+    char logPath[ScoreLog::PATH_SIZE];
+
+    // log opened for appends, -1 if closed
+    int fd;
+    ScoreLog::Sync sync;
+
+    // records appended and not synced yet (PERIODIC)
+    std::atomic<bool> dirty;
+
+    std::thread compactor;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    // read by the last reload()
+    ScoreLog::Mark mark;
+
+    /**
+     * @brief compactor thread body
+     */
+    void run();
+
+    /**
+     * @brief writes a header with a new generation at offset 0
+     *
+     * the generation is the one of the current header plus one,
+     * or a random one if fd has no valid header
+     */
+    static bool writeHeader(int fd);
+
+    /**
+     * @brief reads and checks the header of the log
+     */
+    static bool readHeader(int fd, ScoreLog::Header& h);
+
+    /**
+     * @brief returns the number of complete records in the log
+     */
+    static std::uint32_t recordsOf(int fd);
+
+    /**
+     * @brief adds to into the valid records of the log from index
+     * from on
+     *
+     * @return the number of complete records in the log
+     */
+    static std::uint32_t replay(int fd, std::uint32_t from,
+    Leaderboard& into);
+
+    /**
+     * @brief fills the snapshot identity of mark (stat of path)
+     */
+    static void stamp(const char* path, ScoreLog::Mark& mark);
+
+    /**
+     * @brief read() with the log lfd (-1 if none) already locked
+     */
+    static bool readLocked(const char* path, int lfd, Leaderboard& board,
+    ScoreLog::Mark& mark);
+
+public:
+    ScoreLog();
+
+    /**
+     * @brief same as close()
+     */
+    ~ScoreLog();
+
+    // owns a descriptor and a thread
+    ScoreLog(const ScoreLog&) = delete;
+    ScoreLog& operator=(const ScoreLog&) = delete;
+
+    /**
+     * @brief opens (or creates) the log of the snapshot at path and
+     * starts the compactor thread
+     *
+     * @return false if the log can't be opened
+     */
+    bool open(const char* path, ScoreLog::Sync sync);
+
+    /**
+     * @brief stops the compactor, compacts a last time and closes
+     * the log
+     */
+    void close();
+
+    /**
+     * @brief returns true between a successful open() and close()
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief appends a score to the log
+     *
+     * @return false if the record was not written
+     */
+    bool append(const char name[4], int score);
+
+    /**
+     * @brief merges the log into a new sorted snapshot
+     *
+     * called by the compactor thread, it can run at any time
+     *
+     * @return false if a file can't be read or written
+     */
+    bool compact();
+
+    /**
+     * @brief read() of the snapshot this log belongs to
+     *
+     * if neither file was replaced since the last reload() into the
+     * same board, only the records appended since are read
+     */
+    bool reload(Leaderboard& board);
+
+    /**
+     * @brief writes the log path of a snapshot path into out
+     *
+     * @return false if it doesn't fit
+     */
+    static bool logPathOf(const char* path, char* out, int cap);
+
+    /**
+     * @brief reads the snapshot at path and the log records it
+     * doesn't hold into board (recovery)
+     *
+     * @return false if neither file can be read
+     */
+    static bool read(const char* path, Leaderboard& board);
+
+    /**
+     * @brief writes board as the snapshot at path and empties its log
+     *
+     * @return false if the snapshot can't be written
+     */
+    static bool replace(const char* path, const Leaderboard& board);
+};
+
+#endif
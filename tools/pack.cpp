@@ -0,0 +1,174 @@
+/**
+ * @file pack.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief level pack converter entry point (make pack)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file converts the builtin maps (MapBuilder), generated maps
+ * (MapGenerator) and bonus level files (Parser format) into a binary
+ * level pack, and lists the content of an existing pack
+ *
+ * usage: bombergirl_pack -o OUT [--builtin] [--generate N] [--seed S]
+ *        [BONUS_FILE...]
+ *        bombergirl_pack --list PACK
+ *
+ */
+
+#include "levelpack.hpp"
+#include "map_generator.hpp"
+#include "maps.hpp"
+#include "parser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s -o OUT [--builtin] [--generate N] "
+    "[--seed S] [BONUS_FILE...]\n", prog);
+    fprintf(stderr, "       %s --list PACK\n", prog);
+    fprintf(stderr, "  --builtin  add the 5 builtin levels first\n");
+    fprintf(stderr, "  --generate N  add N generated levels, seeds S .. "
+    "S + N - 1 (default S 1)\n");
+    fprintf(stderr, "  BONUS_FILE  a level in the bonus.csv format\n");
+}
+
+/**
+ * @brief returns the file name without directories
+ */
+static const char* baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash != nullptr ? slash + 1 : path;
+}
+
+static int listPack(const char* path) {
+    LevelPack pack;
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        pack.open(path);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s: %s\n", path, e.what());
+        return 1;
+    }
+    double us = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+
+    printf("%s: %u levels of %ux%u, opened in %.1f us\n", path,
+    pack.size(), (unsigned)pack.width(), (unsigned)pack.height(), us);
+
+    for (unsigned int i = 0; i < pack.size(); i++) {
+        LevelPack::Entry e = pack.at(i);
+        printf("%4u  %-15s  %u enemies\n", i, e.name, e.spawnCount);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* out = nullptr;
+    bool builtin = false;
+    int generated = 0;
+    unsigned long long seed = 1;
+    int firstFile = argc;
+
+    if (argc == 3 && strcmp(argv[1], "--list") == 0) {
+        return listPack(argv[2]);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else if (strcmp(argv[i], "--builtin") == 0) {
+            builtin = true;
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generated = atoi(argv[++i]);
+            if (generated < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            firstFile = i;
+            break;
+        }
+    }
+
+    const int files = argc - firstFile;
+    const int count = (builtin ? 5 : 0) + generated + files;
+    if (out == nullptr || count == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // a Map is a few KB, every map is kept until the pack is written
+    Map** maps = new Map*[count];
+    const char** names = new const char*[count];
+    // generated levels are named after their seed
+    char (*seedNames)[LevelPack::NAME_SIZE] =
+    new char[generated > 0 ? generated : 1][LevelPack::NAME_SIZE];
+    int n = 0;
+
+    if (builtin) {
+        maps[n] = new Map(MapBuilder::motherboard());
+        names[n++] = "motherboard";
+        maps[n] = new Map(MapBuilder::ram());
+        names[n++] = "ram";
+        maps[n] = new Map(MapBuilder::storage());
+        names[n++] = "storage";
+        maps[n] = new Map(MapBuilder::cpu());
+        names[n++] = "cpu";
+        maps[n] = new Map(MapBuilder::gpu());
+        names[n++] = "gpu";
+    }
+
+    MapGenerator generator;
+    for (int i = 0; i < generated; i++) {
+        const unsigned long long s = seed + (unsigned long long)i;
+        maps[n] = new Map();
+        generator.generate(s, *maps[n]);
+        snprintf(seedNames[i], LevelPack::NAME_SIZE, "gen-%llu", s);
+        names[n++] = seedNames[i];
+    }
+
+    int status = 0;
+    for (int i = firstFile; i < argc; i++) {
+        char err[128];
+        Map* map = new Map();
+        if (!Parser::loadBonusFile(argv[i], *map, err, sizeof(err))) {
+            fprintf(stderr, "%s: %s\n", argv[i], err);
+            delete map;
+            status = 1;
+            break;
+        }
+        maps[n] = map;
+        names[n++] = baseName(argv[i]);
+    }
+
+    if (status == 0) {
+        try {
+            LevelPack::write(out, maps, names, (unsigned int)n);
+            printf("%s: %d levels\n", out, n);
+        } catch (const std::exception& e) {
+            fprintf(stderr, "%s: %s\n", out, e.what());
+            status = 1;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        delete maps[i];
+    }
+    delete[] maps;
+    delete[] names;
+    delete[] seedNames;
+
+    return status;
+}
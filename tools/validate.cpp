@@ -0,0 +1,424 @@
+/**
+ * @file validate.cpp
+ * @author Martina Lisa Saffo Ramponi (0001220008)
+ * @brief level file validator entry point (make validate)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * this file checks many bonus level files (Parser format) at once,
+ * every file is parsed and analyzed (MapAnalyzer) on a pool of
+ * worker threads, the results are printed in file name order
+ *
+ * every level of a multi-level file (BonusPack) is checked, the
+ * result of the file is its first failing level, or its hardest
+ *
+ * usage: bombergirl_validate [-j N] [--json] [--warnings] PATH...
+ *
+ * a PATH can be a level file or a directory, the files of a
+ * directory are checked (not its subdirectories, hidden files are
+ * skipped)
+ *
+ * exit status: 0 if every level is playable, 1 if one is not,
+ * 2 on a usage error
+ *
+ */
+
+#include "bonus_pack.hpp"
+#include "map_analyzer.hpp"
+#include "maps.hpp"
+#include "parser.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <thread>
+
+// longest path kept, longer names are skipped with a message
+static const int PATH_SIZE = 512;
+
+/**
+ * @brief a level file and what was found in it
+ */
+struct Job {
+    char path[PATH_SIZE];
+
+    // levels in the file and the one reported (from 0)
+    int levels;
+    int level;
+
+    // parser errors, none if the level was parsed
+    Parser::Diagnostics parse;
+
+    MapAnalyzer::Report report;
+};
+
+/**
+ * @brief the files to check, grown while the arguments are read
+ */
+struct JobList {
+    Job* jobs = nullptr;
+    int count = 0;
+    int capacity = 0;
+};
+
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [-j N] [--json] [--warnings] PATH...\n",
+    prog);
+    fprintf(stderr, "  -j N        worker threads (default: one per "
+    "core)\n");
+    fprintf(stderr, "  --json      print the results as JSON\n");
+    fprintf(stderr, "  --warnings  a warning also makes the level fail\n");
+    fprintf(stderr, "  PATH        a level file or a directory of level "
+    "files\n");
+}
+
+static bool addJob(JobList& list, const char* path) {
+    if (strlen(path) >= (std::size_t)PATH_SIZE) {
+        fprintf(stderr, "%s: path too long, skipped\n", path);
+        return false;
+    }
+
+    if (list.count == list.capacity) {
+        int capacity = list.capacity > 0 ? list.capacity * 2 : 64;
+        Job* jobs = new Job[capacity];
+        for (int i = 0; i < list.count; i++) {
+            jobs[i] = list.jobs[i];
+        }
+        delete[] list.jobs;
+        list.jobs = jobs;
+        list.capacity = capacity;
+    }
+
+    Job& job = list.jobs[list.count++];
+    strcpy(job.path, path);
+    job.levels = 0;
+    job.level = 0;
+    job.parse.count = 0;
+    job.parse.total = 0;
+    return true;
+}
+
+/**
+ * @brief adds the regular files of a directory
+ */
+static bool addDirectory(JobList& list, const char* dir) {
+    DIR* d = opendir(dir);
+    if (d == nullptr) {
+        fprintf(stderr, "%s: cannot open the directory\n", dir);
+        return false;
+    }
+
+    const std::size_t dirLength = strlen(dir);
+    const bool slash = dirLength > 0 && dir[dirLength - 1] == '/';
+
+    struct dirent* e;
+    while ((e = readdir(d)) != nullptr) {
+        if (e->d_name[0] == '.'){
+            continue;
+        }
+
+        char path[PATH_SIZE];
+        int n = snprintf(path, sizeof(path), "%s%s%s", dir,
+        slash ? "" : "/", e->d_name);
+        if (n < 0 || n >= (int)sizeof(path)) {
+            fprintf(stderr, "%s/%s: path too long, skipped\n", dir,
+            e->d_name);
+            continue;
+        }
+
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)){
+            continue;
+        }
+
+        addJob(list, path);
+    }
+
+    closedir(d);
+    return true;
+}
+
+static int comparePaths(const void* a, const void* b) {
+    return strcmp(((const Job*)a)->path, ((const Job*)b)->path);
+}
+
+static bool passed(const Job& job, bool strict) {
+    if (job.parse.total > 0){
+        return false;
+    }
+    return MapAnalyzer::playable(job.report) &&
+    (!strict || job.report.warnings == 0);
+}
+
+/**
+ * @brief parses and analyzes the jobs taken from next, until none
+ * is left
+ */
+static void worker(JobList* list, std::atomic<int>* next, bool strict) {
+    // a Map and a Report are a few KB, one of each per worker
+    Map* map = new Map();
+    MapAnalyzer::Report* report = new MapAnalyzer::Report();
+    Parser::Diagnostics* parse = new Parser::Diagnostics();
+    BonusPack file;
+
+    for (;;) {
+        const int i = next->fetch_add(1);
+        if (i >= list->count){
+            break;
+        }
+
+        Job& job = list->jobs[i];
+        if (!file.open(job.path, &job.parse)){
+            continue;
+        }
+
+        // the first failing level is reported, else the hardest
+        bool failed = false;
+        for (int k = 0; ; k++) {
+            BonusPack::Result r = file.read(k, *map, parse);
+            if (r == BonusPack::Result::END){
+                break;
+            }
+            job.levels++;
+
+            if (r == BonusPack::Result::FAILED) {
+                if (!failed) {
+                    job.parse = *parse;
+                    job.level = k;
+                    failed = true;
+                }
+                continue;
+            }
+
+            MapAnalyzer::analyze(*map, *report);
+            const bool bad = !MapAnalyzer::playable(*report) ||
+            (strict && report->warnings > 0);
+            if (!failed && (bad || k == 0 ||
+            report->difficulty > job.report.difficulty)) {
+                job.report = *report;
+                job.level = k;
+                failed = bad;
+            }
+        }
+        file.close();
+    }
+
+    delete parse;
+    delete report;
+    delete map;
+}
+
+// SECTION OUTPUT
+
+/**
+ * @brief prints s as a JSON string
+ */
+static void printJsonString(const char* s) {
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if (c < 0x20) {
+            printf("\\u%04x", c);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+/**
+ * @brief prints the path, and the reported level of a multi-level file
+ */
+static void printName(const Job& job) {
+    if (job.levels > 1) {
+        printf("%s [level %d/%d]", job.path, job.level + 1, job.levels);
+    } else {
+        printf("%s", job.path);
+    }
+}
+
+static void printText(const Job& job, bool strict) {
+    printName(job);
+    if (job.parse.total > 0) {
+        printf(": FAIL  %d parse errors\n", job.parse.total);
+        for (int i = 0; i < job.parse.count; i++) {
+            char msg[160];
+            Parser::formatError(job.parse.errors[i], msg, sizeof(msg));
+            printf("  error   %s\n", msg);
+        }
+        if (job.parse.total > job.parse.count) {
+            printf("  ... and %d more\n",
+            job.parse.total - job.parse.count);
+        }
+        return;
+    }
+
+    const MapAnalyzer::Report& r = job.report;
+    printf(": %s  difficulty %.1f, %d enemies, exit %d steps / "
+    "%d walls\n", passed(job, strict) ? "ok  " : "FAIL",
+    r.difficulty, r.walkers + r.patrollers + r.chasers, r.gateSteps,
+    r.gateWalls);
+
+    for (int i = 0; i < r.findingCount; i++) {
+        const MapAnalyzer::Finding& f = r.findings[i];
+        printf("  %s (%u,%u): %s\n",
+        f.severity == MapAnalyzer::Severity::ERROR ? "error  " : "warning",
+        (unsigned)f.x, (unsigned)f.y, f.message);
+    }
+
+    const int dropped = r.errors + r.warnings - r.findingCount;
+    if (dropped > 0) {
+        printf("  ... and %d more\n", dropped);
+    }
+}
+
+static void printJson(const Job& job, bool strict, bool last) {
+    printf("    {\"path\": ");
+    printJsonString(job.path);
+    printf(", \"ok\": %s", passed(job, strict) ? "true" : "false");
+    printf(", \"levels\": %d, \"level\": %d", job.levels, job.level + 1);
+
+    if (job.parse.total > 0) {
+        printf(", \"parse_error_count\": %d, \"parse_errors\": [",
+        job.parse.total);
+        for (int i = 0; i < job.parse.count; i++) {
+            const Parser::Error& e = job.parse.errors[i];
+            printf("%s{\"line\": %d, \"column\": %d, \"message\": ",
+            i > 0 ? ", " : "", e.line, e.column);
+            printJsonString(e.message);
+            putchar('}');
+        }
+        printf("]}%s\n", last ? "" : ",");
+        return;
+    }
+
+    const MapAnalyzer::Report& r = job.report;
+    printf(", \"errors\": %d, \"warnings\": %d", r.errors, r.warnings);
+    printf(", \"difficulty\": %.2f, \"threat\": %.2f", r.difficulty,
+    r.threat);
+    printf(", \"walkers\": %d, \"patrollers\": %d, \"chasers\": %d",
+    r.walkers, r.patrollers, r.chasers);
+    printf(", \"open\": %d, \"solid\": %d, \"destructible\": %d",
+    r.open, r.solid, r.destructible);
+    printf(", \"reachable_walking\": %d, \"reachable_bombing\": %d",
+    r.reachableWalking, r.reachableBombing);
+    printf(", \"exit_steps\": %d, \"exit_walls\": %d, "
+    "\"nearest_enemy\": %d", r.gateSteps, r.gateWalls, r.nearestEnemy);
+
+    printf(", \"findings\": [");
+    for (int i = 0; i < r.findingCount; i++) {
+        const MapAnalyzer::Finding& f = r.findings[i];
+        printf("%s{\"severity\": \"%s\", \"x\": %u, \"y\": %u, "
+        "\"message\": ", i > 0 ? ", " : "",
+        f.severity == MapAnalyzer::Severity::ERROR ? "error" : "warning",
+        (unsigned)f.x, (unsigned)f.y);
+        printJsonString(f.message);
+        putchar('}');
+    }
+    printf("]}%s\n", last ? "" : ",");
+}
+
+//!SECTION
+
+int main(int argc, char** argv) {
+    int threads = (int)std::thread::hardware_concurrency();
+    bool json = false;
+    bool strict = false;
+    JobList list;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            if (threads <= 0) {
+                usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--warnings") == 0) {
+            strict = true;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            struct stat st;
+            if (stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+                addDirectory(list, argv[i]);
+            } else {
+                // a missing file fails in the parser, with the others
+                addJob(list, argv[i]);
+            }
+        }
+    }
+
+    if (list.count == 0) {
+        usage(argv[0]);
+        delete[] list.jobs;
+        return 2;
+    }
+
+    if (threads <= 0){
+        threads = 1;
+    }
+    if (threads > list.count){
+        threads = list.count;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::atomic<int> next(0);
+    std::thread* pool = new std::thread[threads];
+    for (int t = 0; t < threads; t++) {
+        pool[t] = std::thread(worker, &list, &next, strict);
+    }
+    for (int t = 0; t < threads; t++) {
+        pool[t].join();
+    }
+    delete[] pool;
+
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+
+    // directory order depends on the file system
+    qsort(list.jobs, (std::size_t)list.count, sizeof(Job), comparePaths);
+
+    // failed counts files, levels every level of every file
+    int failed = 0;
+    int levels = 0;
+    for (int i = 0; i < list.count; i++) {
+        if (!passed(list.jobs[i], strict)){
+            failed++;
+        }
+        levels += list.jobs[i].levels;
+    }
+
+    if (json) {
+        printf("{\n  \"files\": %d,\n  \"levels\": %d,\n", list.count,
+        levels);
+        printf("  \"failed\": %d,\n", failed);
+        printf("  \"threads\": %d,\n  \"elapsed_ms\": %.3f,\n", threads, ms);
+        printf("  \"results\": [\n");
+        for (int i = 0; i < list.count; i++) {
+            printJson(list.jobs[i], strict, i == list.count - 1);
+        }
+        printf("  ]\n}\n");
+    } else {
+        for (int i = 0; i < list.count; i++) {
+            printText(list.jobs[i], strict);
+        }
+        printf("%d files (%d levels), %d failed, %.1f ms on %d threads\n",
+        list.count, levels, failed, ms, threads);
+    }
+
+    delete[] list.jobs;
+    return failed > 0 ? 1 : 0;
+}